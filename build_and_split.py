@@ -14,6 +14,7 @@ from timeit import default_timer as timer
 parser = argparse.ArgumentParser(description="Build and Split case", prefix_chars='-')
 parser.add_argument("project_name", type = str, help = "Name of scheme")
 parser.add_argument("-c", type = str, help = "Case to test", required=True)
+parser.add_argument("--binary", action='store_true', default=False, help = "Write the quantities of the SDDs in binary files")
 args = parser.parse_args()
 
 project_name = args.project_name
@@ -52,4 +53,4 @@ print("Build case %s in %s second(s)" % (case_path, int((end - start))))
 
 for (nSDD_X, nSDD_Y) in nSDD:
 	print("Splitting into " + str((nSDD_X, nSDD_Y)))
-	sdd.split_case(init_path, nSDD_X, nSDD_Y, qty_name_list)
+	sdd.split_case(init_path, nSDD_X, nSDD_Y, qty_name_list, args.binary)
@@ -48,6 +48,14 @@ def build_case(case_path, output_dir, force_build = False):
 
     # Merging uid and bc dictionaries
     coords_to_uid_bc = io.gen_coords_to_uid_bc(case.Nx, case.Ny, case.BClayer)
+
+    # Each ghost ring must be complete, corners included: the deep halo
+    # reads all of them.
+    missing = sorted(set(coords_to_uid_bc) - set(coords_to_bc))
+    if missing:
+        print('Missing boundary conditions in', case_path, 'for the ghost cells', missing[:8], '...' if len(missing) > 8 else '')
+        sys.exit(1)
+
     ds = [coords_to_uid_bc, coords_to_bc]
     coords_to_uid_and_bc = dict()
     for coord in coords_to_bc:
@@ -57,7 +65,7 @@ def build_case(case_path, output_dir, force_build = False):
     io.make_sure_path_exists(output_dir)
 
     # Write scheme info
-    io.write_scheme_info(output_dir, case.T, case.CFL, case.gamma)
+    io.write_scheme_info(output_dir, case.T, case.CFL, case.gamma, getattr(case, 'schemeOptions', None))
 
     # Write domain
     io.write_domain(output_dir, case.lx, case.ly, case.Nx, case.Ny, coords_to_uid, case.BClayer)
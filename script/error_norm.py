@@ -3,7 +3,7 @@
 
 import __future__
 import numpy as np
-from script.rio import read_converter_1D, make_sure_path_exists
+from script.rio import read_converter, read_quantity, make_sure_path_exists
 from timeit import default_timer as timer
 import sys
 import os
@@ -36,7 +36,7 @@ def compute(data_path, qty_name_list, solver):
     """
     uid_to_coords = dict()
     start = timer()
-    Nx, Ny, dx, dy = read_converter_1D(data_path, uid_to_coords)
+    Nx, Ny, dx, dy = read_converter(data_path, uid_to_coords)
     end = timer()
     print("Time to load coordinates converter of %s elements" % (Nx * Ny), "%s second(s)" % int((end - start)))
         
@@ -76,19 +76,10 @@ def compute(data_path, qty_name_list, solver):
     result = {'N' : Nx*Ny}
     # Must load rho in any case.
     start = timer()
-    rho = np.zeros(Nx)
-    counter = 0
-    with open(os.path.join(data_path, 'rho.dat'), 'r') as quantity_f:
-        for line in quantity_f:
-            if counter == Nx:
-                break
-            
-            line_list = line.split(' ')
-            pos = int(line_list[0])
-            if pos in uid_to_coords:
-                coords = uid_to_coords[pos]
-                rho[coords[0]] = float(line_list[1])
-                counter = counter + 1
+    # The diagonal of a square domain, else its first row or column.
+    data = np.zeros((Nx, Ny))
+    read_quantity(data, data_path, uid_to_coords, 'rho')
+    rho = np.diagonal(data) if Nx == Ny else data[:, 0]
 
     end = timer()
     print("Time to load quantity rho of %s elements" % (Nx * Ny), "%s second(s)" % int((end - start)))
@@ -62,7 +62,7 @@ def build(quantityDict, coords_to_uid, coords_to_bc, Nx, Ny, lx, ly, BClayer):
             #coords_to_bc[(i, Ny - 1 + k)] = {'D': {"rho": u0, "rhoE": 1/2*u0**2*rho0, "pressure": 0,"rhou_x": -u0*x/sqrt(x**2+y**2)*rho0, "rhou_y": -u0*y/sqrt(x**2+y**2)*rho0}}
 
         # Right border
-        for j in range(Ny, -k, -1):
+        for j in range(Ny - 1 + k, -k, -1):
             x = (Nx + 0.5) * dx
             y = (j + 0.5) * dy
             ir = 1. / np.sqrt(x**2 + y**2)
@@ -73,7 +73,7 @@ def build(quantityDict, coords_to_uid, coords_to_bc, Nx, Ny, lx, ly, BClayer):
             #coords_to_bc[(Nx - 1 + k, j)] = {'D': {"rho": u0, "rhoE": 1/2*u0**2*rho0, "pressure": 0,"rhou_x": -u0*x/sqrt(x**2+y**2)*rho0, "rhou_y": -u0*y/sqrt(x**2+y**2)*rho0}}
 
         # Bottom border
-        for i in range(Nx, -k, -1):
+        for i in range(Nx - 1 + k, -k, -1):
             coords_to_bc[(i, -k)] = {'N': {"rho": 1, "rhoE": 1, "pressure": 1, "rhou_x": 1, "rhou_y": -1}}
 
     # ------------------------------------------------------------------------------
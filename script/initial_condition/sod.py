@@ -48,12 +48,12 @@ def build(quantityDict, coords_to_uid, coords_to_bc, Nx, Ny, lx, ly, BClayer, BC
                 coords_to_bc[(i, Ny - 1 + k)] = {'N': {"rho": 1, "rhoE": 1, "pressure": 1, "rhou_x": ux, "rhou_y": -1}}
 
             # Right border
-            for j in range(Ny, -k, -1):
+            for j in range(Ny - 1 + k, -k, -1):
                 uy = 1 if j >= 0 and j < Ny else -1
                 coords_to_bc[(Nx - 1 + k, j)] = {'N': {"rho": 1, "rhoE": 1, "pressure": 1,"rhou_x": -1, "rhou_y": uy}}
 
             # Bottom border
-            for i in range(Nx, -k, -1):
+            for i in range(Nx - 1 + k, -k, -1):
                 ux = 1 if i >= 0 and i < Nx else -1
                 coords_to_bc[(i, -k)] = {'N': {"rho": 1, "rhoE": 1, "pressure": 1, "rhou_x": ux, "rhou_y": -1}}
 
@@ -69,11 +69,11 @@ def build(quantityDict, coords_to_uid, coords_to_bc, Nx, Ny, lx, ly, BClayer, BC
                 coords_to_bc[(i, Ny - 1 + k)] = {BCtype: {"rho": 0.125, "rhoE" : 0.1 / (gamma - 1.0), "pressure" : 0.1}}
 
             # Right border
-            for j in range(Ny, -k, -1):
+            for j in range(Ny - 1 + k, -k, -1):
                 coords_to_bc[(Nx - 1 + k, j)] = {BCtype: {"rho": 0.125, "rhoE" : 0.1 / (gamma - 1.0), "pressure" : 0.1}}
 
             # Bottom border
-            for i in range(Nx, -k, -1):
+            for i in range(Nx - 1 + k, -k, -1):
                 coords_to_bc[(i, -k)] = {BCtype: {"rho": 1.0, "rhoE" : 1.0 / (gamma - 1.0), "pressure" : 1.0}}
 
     # ------------------------------------------------------------------------------
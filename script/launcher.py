@@ -5,6 +5,7 @@ import __future__
 import os
 import sys
 import socket
+import filecmp
 import numpy as np
 
 sys.path.insert(1, os.path.join(sys.path[0], 'script', 'study', 'sedov'))
@@ -110,6 +111,81 @@ def create_ref(engineOptionDict, icond_path, input_path, ref_path):
         sdd.merge_quantity(ref_path, ref_path, q_str)
     rmtree(os.path.join(ref_path, "sdd0"), ignore_errors=True)
 
+def check_restart(engine, engineOptionDict, split_path, output_path, test, qty_name_list, output):
+    '''
+    Restarts the run of output_path from its checkpoints (-R) and checks that
+    it ends with the same quantities and snapshots, bit for bit. The newest
+    checkpoint of sdd0 is removed first, as if the run had stopped before the
+    other SDDs wrote theirs: the SDDs must agree on an older one.
+    '''
+    nSDD = test['nSDD'][0] * test['nSDD'][1]
+    restart_path = output_path + "-restart"
+    rmtree(restart_path, ignore_errors=True)
+    copytree(output_path, restart_path)
+
+    # Iterations of the checkpoints of sdd0.
+    sdd0_path = os.path.join(restart_path, 'sdd0')
+    checkpoints = dict()
+    for f in os.listdir(sdd0_path):
+        if f.startswith('checkpoint-') and f.endswith('.bin'):
+            checkpoints[io.read_checkpoint_iteration(os.path.join(sdd0_path, f))] = f
+    if len(checkpoints) < 2:
+        print("Not enough checkpoints to check the restart: run at least 2 * checkpointIterations iterations with checkpointKeep >= 2.")
+        sys.exit(1)
+    os.remove(os.path.join(sdd0_path, checkpoints.pop(max(checkpoints))))
+    iteration = max(checkpoints)
+
+    # Remove what the restart must write again: the final quantities and the
+    # snapshots taken after the checkpoint.
+    for q_str in qty_name_list:
+        for ext in ['.dat', '.bin']:
+            if os.path.isfile(os.path.join(restart_path, q_str + ext)):
+                os.remove(os.path.join(restart_path, q_str + ext))
+    for n in range(nSDD):
+        sdd_path = os.path.join(restart_path, 'sdd' + str(n))
+        for q_str in qty_name_list:
+            for ext in ['.dat', '.bin']:
+                if os.path.isfile(os.path.join(sdd_path, q_str + ext)):
+                    os.remove(os.path.join(sdd_path, q_str + ext))
+        if os.path.isfile(os.path.join(sdd_path, 'snapshots.dat')):
+            for snapshot_id, snapshot_iteration, t in io.read_snapshots(sdd_path):
+                if snapshot_iteration > iteration:
+                    for f in os.listdir(sdd_path):
+                        if f.endswith('-' + str(snapshot_id) + '.bin') and not f.startswith('checkpoint-'):
+                            os.remove(os.path.join(sdd_path, f))
+
+    print(COLOR_BLUE + "Restarting engine from iteration " + str(iteration) + COLOR_ENDC)
+    engine.run(split_path, restart_path, engineOptionDict['node_number'], nSDD, int(np.ceil(test['nCoresPerSDD'])), ['-R'])
+
+    # Compare the final quantities.
+    for path in [output_path, restart_path]:
+        sdd.merge_domain(path, path)
+        for q_str in qty_name_list:
+            sdd.merge_quantity(path, path, q_str, output)
+    result, qty, error_data = compare_data(output_path, restart_path, qty_name_list, engineOptionDict['precision'])
+    if not result:
+        print("Restart: ERROR, different result for quantity " + qty)
+        sys.exit(1)
+
+    # Compare the snapshots.
+    for n in range(nSDD):
+        sdd_path = os.path.join(output_path, 'sdd' + str(n))
+        if not os.path.isfile(os.path.join(sdd_path, 'snapshots.dat')):
+            continue
+        restart_sdd_path = os.path.join(restart_path, 'sdd' + str(n))
+        snapshots = io.read_snapshots(sdd_path)
+        if snapshots != io.read_snapshots(restart_sdd_path):
+            print("Restart: ERROR, different snapshots for sdd" + str(n))
+            sys.exit(1)
+        for snapshot_id, snapshot_iteration, t in snapshots:
+            for f in os.listdir(sdd_path):
+                if f.endswith('-' + str(snapshot_id) + '.bin') and not f.startswith('checkpoint-'):
+                    if not filecmp.cmp(os.path.join(sdd_path, f), os.path.join(restart_sdd_path, f), shallow=False):
+                        print("Restart: ERROR, different snapshot sdd" + str(n) + "/" + f)
+                        sys.exit(1)
+
+    print("Restart from iteration %s: OK." % iteration)
+
 def launch_test(tmp_dir, engineOptionDict, case_name, test, compare_with_ref, fastref, forceref, forcebuild):
     # Check values for pure sequential test.
     if engineOptionDict['compiler'] != 'mpi':
@@ -163,11 +239,25 @@ def launch_test(tmp_dir, engineOptionDict, case_name, test, compare_with_ref, fa
     split_path = sdd.split_case(input_path, nSDD_X, nSDD_Y, qty_name_list)
 
     # Add exec options
-    io.write_exec_options(split_path, nSDD_X * nSDD_Y, nSDD_X, nSDD_Y, test['nSDS'], test['SDSgeom'], test['nThreads'], test['nCommonSDS'], test['nCoresPerSDD'])
+    # With the random rounding modes, the SDDs must agree on the time step.
+    execOptions = dict(test.get('execOptions') or {})
+    output = execOptions.get('output', 'text')
+    if engineOptionDict['rounding'] == 'random' or engineOptionDict['rounding'] == 'average':
+        execOptions['dtReduction'] = 'agreed'
+    io.write_exec_options(split_path, nSDD_X * nSDD_Y, nSDD_X, nSDD_Y, test['nSDS'], test['SDSgeom'], test['nThreads'], test['nCommonSDS'], test['nCoresPerSDD'], execOptions)
 
     # Copying exec_options and scheme_info in input path too
     copyfile(os.path.join(input_path, 'scheme_info.dat'), os.path.join(split_path, 'scheme_info.dat'))
 
+    # Scheme options of the test replace the ones of the case. With
+    # checkpointIterations, the restart from the checkpoints is checked.
+    schemeOptions = test.get('schemeOptions') or {}
+    restart = 'checkpointIterations' in schemeOptions
+    if schemeOptions:
+        T, CFL, gamma, options = io.read_scheme_info(input_path)
+        options.update(schemeOptions)
+        io.write_scheme_info(split_path, T, CFL, gamma, options)
+
     # Building output paths (the engine cannot create them itself)
     output_path = os.path.join(tmp_dir, project_name, case_name, "final")
     rmtree(output_path, ignore_errors=True)
@@ -178,17 +268,20 @@ def launch_test(tmp_dir, engineOptionDict, case_name, test, compare_with_ref, fa
     engine = Engine(engineOptionDict, engineOptionDict['must_compile'])
 
     print(COLOR_BLUE + "Calling engine" + COLOR_ENDC)
-    run_option = [] if compare_with_ref == True or fastref == True or engineOptionDict['rounding'] != None else ['--dry']
+    run_option = [] if compare_with_ref == True or fastref == True or restart == True or engineOptionDict['rounding'] != None else ['--dry']
 
     engine.run(split_path, output_path, engineOptionDict['node_number'], nSDD_X * nSDD_Y, int(np.ceil(test['nCoresPerSDD'])), run_option)
     end = timer()
 
+    if restart == True:
+        check_restart(engine, engineOptionDict, split_path, output_path, test, qty_name_list, output)
+
     # Now, look for differences, if any.
     if compare_with_ref == True:
         print(COLOR_BLUE + "Merging final data" + COLOR_ENDC)
         sdd.merge_domain(output_path, output_path)
         for q_str in qty_name_list:
-            sdd.merge_quantity(output_path, output_path, q_str)
+            sdd.merge_quantity(output_path, output_path, q_str, output)
 
         # Getting/building reference for the case
         create_ref(engineOptionDict, icond_path, input_path, refer_path)
@@ -206,7 +299,7 @@ def launch_test(tmp_dir, engineOptionDict, case_name, test, compare_with_ref, fa
         io.make_sure_path_exists(refer_path)
         sdd.merge_domain(output_path, refer_path)
         for q_str in qty_name_list:
-            sdd.merge_quantity(output_path, refer_path, q_str)
+            sdd.merge_quantity(output_path, refer_path, q_str, output)
 
     # Export error norm
     if engineOptionDict['rounding'] != None and engineOptionDict['rounding'] != 'nearest':
@@ -214,7 +307,7 @@ def launch_test(tmp_dir, engineOptionDict, case_name, test, compare_with_ref, fa
         sdd.merge_domain(output_path, refer_path)
         # Merge everything first.
         for q_str in qty_name_list:
-            sdd.merge_quantity(output_path, refer_path, q_str)
+            sdd.merge_quantity(output_path, refer_path, q_str, output)
 
         # Then compute the errors.
         err = script.error_norm.compute(refer_path, qty_name_list, test['solver'])
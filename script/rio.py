@@ -5,6 +5,7 @@ import __future__
 import numpy as np
 import os
 import errno
+import struct
 import sys
 from decimal import Decimal
 from shutil import copy2
@@ -38,39 +39,6 @@ def read_converter(input_dir, uid_to_coords):
 
     return Nx, Ny, dx, dy
 
-def read_converter_1D(input_dir, uid_to_coords):
-    with open(os.path.join(input_dir, 'domain.dat'), 'r') as domain_f:
-        # Reading mesh info on the first line
-        # Read dx and dy in first line
-        first_line = domain_f.readline().split()
-        lx = Decimal(first_line[2])
-        ly = Decimal(first_line[3])
-        Nx = int(first_line[4])
-        Ny = int(first_line[5])
-
-        dx = lx / Nx
-        dy = ly / Ny
-
-        if Nx == Ny:
-            for line in domain_f:
-                line_list = line.split()
-                if line_list:
-                    i = int(line_list[1])
-                    j = int(line_list[2])
-                    if i == j:
-                        uid_to_coords[int(line_list[0])] = (i, j)
-        else:
-            for line in domain_f:
-                line_list = line.split()
-                if line_list:
-                    i = int(line_list[1])
-                    j = int(line_list[2])
-                    if i == 0 or j == 0:
-                        uid_to_coords[int(line_list[0])] = (i, j)
-
-    return Nx, Ny, dx, dy
-
-
 def read_quantity(data, input_dir, uid_to_coords, quantity_name):
 
 #    with open(os.path.join(input_dir, quantity_name + '.dat'), 'r') as quantity_f:
@@ -80,11 +48,20 @@ def read_quantity(data, input_dir, uid_to_coords, quantity_name):
 #            value = Decimal(line_list[1])
 #            data[coords[0]][coords[1]] = value
 
+    binary_file_name = os.path.join(input_dir, quantity_name + '.bin')
+    if os.path.isfile(binary_file_name):
+        values = read_quantity_binary(binary_file_name)
+        data[:values.shape[1], :values.shape[0]] = values.T
+        return
+
     quantity = np.loadtxt(os.path.join(input_dir, quantity_name + '.dat'))
     for i, v in quantity:
         coords = uid_to_coords[int(i)]
         data[coords[0]][coords[1]] = v
 
+def quantity_exists(input_dir, quantity_name):
+    return os.path.isfile(os.path.join(input_dir, quantity_name + '.bin')) or os.path.isfile(os.path.join(input_dir, quantity_name + '.dat'))
+
 def read_exec_options(input_dir):
     with open(os.path.join(output_dir, 'exec_options.dat'), 'r') as f:
         line_list = f.readline().split()
@@ -146,11 +123,11 @@ def gen_coords_to_uid_bc(Nx, Ny, BClayer):
             coords_to_uid_bc[(i, Ny - 1 + k)] = uid
             uid += 1
         # Right border
-        for j in range(Ny, -k, -1):
+        for j in range(Ny - 1 + k, -k, -1):
             coords_to_uid_bc[(Nx - 1 + k, j)] = uid
             uid += 1
         # Bottom border
-        for i in range(Nx, -k, -1):
+        for i in range(Nx - 1 + k, -k, -1):
             coords_to_uid_bc[(i, -k)] = uid
             uid += 1
     return coords_to_uid_bc
@@ -176,13 +153,80 @@ def write_quantity(output_dir, quant_name, uid_to_val):
     x = np.arange(len(uid_to_val))
     np.savetxt(os.path.join(output_dir, quant_name + '.dat'), np.c_[x, uid_to_val], fmt='%d\t%16.16g')
 
-def write_scheme_info(output_dir, T, CFL, gamma):
+# Binary quantity files of the SDDs (sddN/<qty>.bin), see IO::QuantityHeader:
+# magic, bytes and significand bits of a value, rounding mode, Nx, Ny, layout
+# (0: row-major), then the values.
+quantity_magic = b'VARIANTQ'
+quantity_header = struct.Struct('=8sIIiIII')
+
+def write_quantity_binary(file_name, data):
+    # data is indexed [j][i], written in row-major order.
+    data = np.ascontiguousarray(data)
+    precision = np.finfo(data.dtype).nmant + 1
+    with open(file_name, 'wb') as f:
+        f.write(quantity_header.pack(quantity_magic, data.dtype.itemsize, precision, 0, data.shape[1], data.shape[0], 0))
+        data.tofile(f)
+
+def read_quantity_binary(file_name):
+    # Returns the values indexed [j][i], as a float64 array when they were
+    # written with another floating point type numpy doesn't know.
+    with open(file_name, 'rb') as f:
+        magic, value_size, precision, rounding, Nx, Ny, layout = quantity_header.unpack(f.read(quantity_header.size))
+        if magic != quantity_magic or layout != 0:
+            raise ValueError("Bad binary quantity file: " + file_name)
+
+        dtype = None
+        for t in (np.float32, np.float64, np.longdouble):
+            if np.dtype(t).itemsize == value_size and np.finfo(t).nmant + 1 == precision:
+                dtype = t
+        if dtype is None:
+            raise ValueError("Unsupported precision of binary quantity file: " + file_name)
+
+        return np.fromfile(f, dtype=dtype, count=Nx * Ny).reshape(Ny, Nx)
+
+def write_scheme_info(output_dir, T, CFL, gamma, options = None):
     with open(os.path.join(output_dir, 'scheme_info.dat'), 'w+') as f:
         f.write(str(T) + " ")
         f.write(str(CFL) + " ")
         f.write(str(gamma) + "\n")
+        # Optional scheme options, written as name=value on the next line
+        # (e.g. snapshotIterations=100 or snapshotInterval=0.01).
+        if options:
+            f.write(" ".join(str(name) + "=" + str(value) for name, value in sorted(options.items())) + "\n")
+
+def read_scheme_info(input_dir):
+    # Returns T, CFL, gamma and the dict of the optional scheme options.
+    with open(os.path.join(input_dir, 'scheme_info.dat'), 'r') as f:
+        T, CFL, gamma = f.readline().split()
+        options = dict(option.split('=', 1) for option in f.read().split())
+    return T, CFL, gamma, options
+
+# Checkpoint files of the SDDs (sddN/checkpoint-k.bin), see
+# IO::CheckpointHeader: magic, bytes of a real, SDD id, iteration, ...
+checkpoint_magic = b'VARIANTC'
+checkpoint_header = struct.Struct('=8sIII')
+
+def read_checkpoint_iteration(file_name):
+    with open(file_name, 'rb') as f:
+        magic, value_size, sdd_id, iteration = checkpoint_header.unpack(f.read(checkpoint_header.size))
+        if magic != checkpoint_magic:
+            raise ValueError("Bad checkpoint file: " + file_name)
+        return iteration
+
+def read_snapshots(sdd_dir):
+    # List of the snapshots written by a SDD, (id, iteration, t): snapshot
+    # id of quantity q is sddN/q-id.bin, merged with
+    # sdd.merge_quantity(split_dir, output_dir, q + '-' + str(id), 'binary').
+    # A restarted run writes again the snapshots after its checkpoint: the
+    # last line of an id is kept.
+    snapshots = dict()
+    with open(os.path.join(sdd_dir, 'snapshots.dat'), 'r') as f:
+        for line in f.readlines():
+            line_list = line.split()
+            snapshots[int(line_list[0])] = (int(line_list[0]), int(line_list[1]), float(line_list[2]))
+    return [snapshots[i] for i in sorted(snapshots)]
 
-def write_exec_options(output_dir, nSDD, nSDD_X, nSDD_Y, nSDS, SDSgeom, nThreads, nCommonSDS, nCoresPerSDD):
+def write_exec_options(output_dir, nSDD, nSDD_X, nSDD_Y, nSDS, SDSgeom, nThreads, nCommonSDS, nCoresPerSDD, options = None):
     with open(os.path.join(output_dir, 'exec_options.dat'), 'w+') as f:
         f.write(str(nSDD) + " ")
         f.write(str(nSDD_X) + " ")
@@ -191,7 +235,12 @@ def write_exec_options(output_dir, nSDD, nSDD_X, nSDD_Y, nSDS, SDSgeom, nThreads
         f.write(SDSgeom + " ")
         f.write(str(nThreads) + " ")
         f.write(str(nCommonSDS) + " ")
-        f.write(str(nCoresPerSDD) + "\n")
+        f.write(str(nCoresPerSDD))
+        # Optional engine options, written as name=value (e.g. cacheKB=256).
+        if options:
+            for name, value in sorted(options.items()):
+                f.write(" " + str(name) + "=" + str(value))
+        f.write("\n")
 
 def write_bc(output_dir, coords_to_uid_and_bc):
     with open(os.path.join(output_dir, 'bc.dat'), 'w+') as f:
@@ -7,6 +7,7 @@ import sys
 import script.rio as io
 from timeit import default_timer as timer
 import numpy as np
+from shutil import copy2
 
 def split_domain(domain_dir, output_dir, nSDD_X, nSDD_Y):
     io.make_sure_path_exists(output_dir)
@@ -112,7 +113,7 @@ def merge_domain(split_dir, output_dir):
 
     domain_f.close()
 
-def split_quantity(quantity_dir, output_dir, quantity_name, sdd_to_coords):
+def split_quantity(quantity_dir, output_dir, quantity_name, sdd_to_coords, binary = False):
 
     quantity_file_name = os.path.join(quantity_dir, quantity_name + '.dat')
 
@@ -128,6 +129,18 @@ def split_quantity(quantity_dir, output_dir, quantity_name, sdd_to_coords):
     nSDD = int(line_split[4]) * int(line_split[5])
     quantity = np.loadtxt(quantity_file_name, usecols=[1])
 
+    # One binary file per SDD, written in one block (see io.write_quantity_binary).
+    if binary:
+        SDD_Nx = int(line_split[2]) // int(line_split[4])
+        SDD_Ny = int(line_split[3]) // int(line_split[5])
+        for SDDid in range(nSDD):
+            SDDpath = os.path.join(output_dir, 'sdd' + str(SDDid))
+            cells = np.array(sdd_to_coords[SDDid], dtype=int)
+            data = np.zeros((SDD_Ny, SDD_Nx))
+            data[cells[:, 2], cells[:, 1]] = quantity[cells[:, 0]]
+            io.write_quantity_binary(os.path.join(SDDpath, quantity_name + '.bin'), data)
+        return
+
     # Opening streams for all SDDs
     for SDDid in range(nSDD):
         SDDpath = os.path.join(output_dir, 'sdd' + str(SDDid))
@@ -243,7 +256,21 @@ def split_bc(bc_dir, output_dir):
 
     return
 
-def merge_quantity(split_dir, output_dir, quantity_name):
+def merge_quantity(split_dir, output_dir, quantity_name, output = 'text'):
+    # io.read_quantity prefers <qty>.bin to <qty>.dat: the file of the other
+    # format, from an earlier merge in output_dir, is removed.
+    stale_file_name = os.path.join(output_dir, quantity_name + ('.dat' if output in ['binary', 'shared'] else '.bin'))
+    if os.path.isfile(stale_file_name):
+        os.remove(stale_file_name)
+
+    # output=shared: the engine wrote the quantity of the whole domain in
+    # split_dir/<qty>.bin, nothing to merge.
+    if output == 'shared':
+        if os.path.abspath(split_dir) != os.path.abspath(output_dir):
+            copy2(os.path.join(split_dir, quantity_name + '.bin'), output_dir)
+        return
+
+
     domain_shortinfo = open(os.path.join(split_dir, "domain.info"), 'r')
     line_domain = domain_shortinfo.readline()
     line_split = line_domain.split()
@@ -251,6 +278,10 @@ def merge_quantity(split_dir, output_dir, quantity_name):
     nSDD_Y = int(line_split[5])
     domain_shortinfo.close()
 
+    if output == 'binary':
+        merge_quantity_binary(split_dir, output_dir, quantity_name, int(line_split[2]), int(line_split[3]), nSDD_X * nSDD_Y)
+        return
+
     qty_stream = open(os.path.join(output_dir, quantity_name + '.dat'), 'w+')
 
     for SDDid in range(nSDD_X * nSDD_Y):
@@ -282,9 +313,27 @@ def merge_quantity(split_dir, output_dir, quantity_name):
 
     qty_stream.close()
 
+# The SDDs wrote sddN/<qty>.bin (exec option output=binary): the merged
+# quantity is a binary file of the whole domain, read by io.read_quantity.
+def merge_quantity_binary(split_dir, output_dir, quantity_name, Nx, Ny, nSDD):
+    data = None
+    for SDDid in range(nSDD):
+        SDDpath = os.path.join(split_dir, 'sdd' + str(SDDid))
+        with open(os.path.join(SDDpath, 'sdd.dat'), 'r') as sdd_f:
+            line_split = sdd_f.readline().split()
+            BL_X = int(line_split[0])
+            BL_Y = int(line_split[1])
+
+        values = io.read_quantity_binary(os.path.join(SDDpath, quantity_name + '.bin'))
+        if data is None:
+            data = np.zeros((Ny, Nx), dtype=values.dtype)
+        data[BL_Y:BL_Y + values.shape[0], BL_X:BL_X + values.shape[1]] = values
+
+    io.write_quantity_binary(os.path.join(output_dir, quantity_name + '.bin'), data)
+
 
-def split_case(domain_dir, nSDD_X, nSDD_Y, qty_name_list):
-    output_dir = os.path.join(domain_dir, str(nSDD_X) + "x" + str(nSDD_Y))
+def split_case(domain_dir, nSDD_X, nSDD_Y, qty_name_list, binary = False):
+    output_dir = os.path.join(domain_dir, str(nSDD_X) + "x" + str(nSDD_Y) + ("-bin" if binary else ""))
     if os.path.isdir(output_dir):
         print("Split already exists")
         return output_dir
@@ -297,7 +346,7 @@ def split_case(domain_dir, nSDD_X, nSDD_Y, qty_name_list):
     split_bc(domain_dir, output_dir)
     for q_str in qty_name_list:
         start = timer()
-        split_quantity(domain_dir, output_dir, q_str, sdd_to_coords)
+        split_quantity(domain_dir, output_dir, q_str, sdd_to_coords, binary)
         end = timer()
         print("Time to split quantity", q_str, "%s second(s)" % int((end - start)))
 
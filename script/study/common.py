@@ -8,7 +8,7 @@ plt.style.use('ggplot')
 from timeit import default_timer as timer
 import argparse
 sys.path.insert(1, os.path.join(sys.path[0], '..'))
-from rio import read_quantity, read_converter
+from rio import read_quantity, read_converter, quantity_exists
 sys.path.insert(1, os.path.join(sys.path[0], '..','..'))
 import config
 
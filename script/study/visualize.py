@@ -14,7 +14,7 @@ if not os.path.isdir(ref_path):
     print("Can't file reference result directory.")
     sys.exit(1)
 
-if not os.path.isfile(os.path.join(ref_path, 'rho.dat')):
+if not quantity_exists(ref_path, 'rho'):
     print("Can't file reference result file.")
     sys.exit(1)
 
@@ -487,3 +487,48 @@ def runTestBattery(engineOptionDict, testBattery):
 
     # Finally
     print(COLOR_GREEN + "\nTest successfully passed\n" + COLOR_ENDC)
+
+def collectTestBattery(engineOptionDict, testBattery, perfInfo = False):
+    """
+    Runs the tests of the battery like runTestBattery, but returns the perfs
+    instead of writing them to the results file: a list of (case name, test,
+    perfs of each run), perfs being the dict of perfs.dat, with the timers of
+    the SDDs under 'perfInfo' (see io.read_perf_info) if perfInfo is set.
+    """
+    if args.test == True:
+        return []
+
+    tmp_dir = config.tmp_dir
+    project_name = engineOptionDict['project_name']
+
+    # Checkt that all cases do exist
+    for cn in testBattery:
+        if not case_exist(project_name, cn):
+            print('Test', project_name, cn, "doesn't exist")
+            sys.exit(1)
+
+    results = []
+    for cn, testList in testBattery.items():
+        # Cleaning tmp directory for new case
+        rmtree(tmp_dir, ignore_errors=True)
+        for test in testList:
+            perfList = []
+            for n in range(test['nRuns']):
+                # Check results and compare to reference (one check for all runs).
+                compare_with_ref = not args.nocheck and n == test['nRuns'] - 1
+
+                # Launch Test
+                tmp_test_path, exec_time = launch_test(tmp_dir, engineOptionDict, cn, test, compare_with_ref, args.fastref, args.forceref, args.forcebuild)
+                if tmp_test_path is None:
+                    # This test was not performed.
+                    continue
+
+                perfs = io.read_perfs(tmp_test_path)
+                if perfInfo:
+                    perfs['perfInfo'] = io.read_perf_info(tmp_test_path, test['nSDD'][0] * test['nSDD'][1])
+                perfList.append(perfs)
+
+            if perfList:
+                results.append((cn, test, perfList))
+
+    return results
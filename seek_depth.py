@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# -*- coding:utf-8 -*-
+
+# Compares the cost of an iteration when the overlap cells are exchanged at
+# each iteration (haloDepth=1) or once every 2 or 3 iterations, the ghost
+# layers being computed redundantly in between. Use it with small SDDs and
+# many of them, where the exchanges are latency bound. The case must have at
+# least 3 boundary layers (BClayer = 3 in its chars.py), e.g.:
+#   ./seek_depth.py eulerRuO1 --case nSod --core 64 --nocheck
+
+import __future__
+import sys
+from seek_common import *
+
+
+nruns = 5
+SDSgeom = 'rectangle'
+haloDepthList = [1, 2, 3]
+sizeList = [(512, 512)]
+
+testBattery = dict()
+for size in sizeList:
+    cn = "%s%sx%s" % (case_name, str(size[0]), str(size[1]))
+    for p in range(max(1, minSdd), maxSdd):
+        for haloDepth in haloDepthList:
+            test = dict()
+            test['nSDD'] = (2**(p - p // 2), 2**(p // 2))
+            test['nCoresPerSDD'] = 1
+            test['nThreads'] = 1
+            test['nSDS'] = 1
+            test['nCommonSDS'] = 0
+            test['execOptions'] = {'haloDepth': haloDepth}
+            testBattery.setdefault(cn, list()).append(test)
+
+battery = compileTestBattery([testBattery], SDSgeom, nruns)
+
+results = []
+for cn, test, perfList in collectTestBattery(engineOptionDict, battery):
+    iterationTimes = [1000. * perfs['loopTime'] / max(1, perfs['nIterations']) for perfs in perfList]
+    results.append((cn, test['nSDD'][0] * test['nSDD'][1], test['execOptions']['haloDepth'], np.median(iterationTimes), np.min(iterationTimes)))
+
+print(COLOR_BLUE + "Time per iteration (us)" + COLOR_ENDC)
+print("%20s %6s %6s %12s %12s" % ('case', 'nSDD', 'depth', 'median', 'min'))
+for r in results:
+    print("%20s %6d %6d %12.2f %12.2f" % r)
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+# -*- coding:utf-8 -*-
+
+# Compares the exchange time per iteration with the overlap cells exchanged
+# through persistent MPI requests (haloRequests=persistent) or requests
+# created at each iteration (haloRequests=immediate). The exchange time of a
+# SDD is its iteration time minus its computation time (timer-iteration.dat
+# and timer-compute.dat), so that the compute noise doesn't hide it. Use it
+# on 1D cases, where the messages are tiny and the setup of the requests
+# dominates, e.g.:
+#   ./seek_halo.py eulerRuO1 --case nNoh --core 4 --nocheck
+
+import __future__
+import sys
+from seek_common import *
+
+
+nruns = 5
+SDSgeom = 'line'
+haloRequestsList = ['immediate', 'persistent']
+sizeList = [(4096, 1), (16384, 1), (131072, 1)]
+
+testBattery = dict()
+for size in sizeList:
+    cn = "%s%sx%s" % (case_name, str(size[0]), str(size[1]))
+    for p in range(max(1, minSdd), maxSdd):
+        for haloRequests in haloRequestsList:
+            test = dict()
+            test['nSDD'] = (2**p, 1)
+            test['nCoresPerSDD'] = 1
+            test['nThreads'] = 1
+            test['nSDS'] = 1
+            test['nCommonSDS'] = 0
+            test['execOptions'] = {'haloRequests': haloRequests}
+            testBattery.setdefault(cn, list()).append(test)
+
+battery = compileTestBattery([testBattery], SDSgeom, nruns)
+
+def exchangeTimes(perfs):
+    # Time per iteration out of the computation of each SDD (us), the
+    # timers being in ms.
+    iterationTime = perfs['perfInfo']['iterationTime']
+    computeTime = perfs['perfInfo']['computeTime']
+    return [1000. * (np.sum(iterationTime[sdd]) - np.sum(computeTime[sdd])) / max(1, np.size(iterationTime[sdd])) for sdd in iterationTime]
+
+results = []
+for cn, test, perfList in collectTestBattery(engineOptionDict, battery, perfInfo = True):
+    # Median and min across the SDDs of all the runs.
+    times = np.concatenate([exchangeTimes(perfs) for perfs in perfList])
+    results.append((cn, test['nSDD'][0] * test['nSDD'][1], test['execOptions']['haloRequests'], np.median(times), np.min(times)))
+
+print(COLOR_BLUE + "Exchange time per iteration (us)" + COLOR_ENDC)
+print("%20s %6s %12s %12s %12s" % ('case', 'nSDD', 'requests', 'median', 'min'))
+for r in results:
+    print("%20s %6d %12s %12.2f %12.2f" % r)
@@ -0,0 +1,41 @@
+#!/usr/bin/env python3
+# -*- coding:utf-8 -*-
+
+# Measures the init of the engine when the number of SDDs grows, up to 4096
+# SDDs (64 x 64): the whole init (initTime) and the building of the
+# subdomains and of their communication maps (setupTime). The run itself is
+# kept short, use a case with a small final time, e.g.:
+#   ./seek_init.py eulerRuO1 --case sod --core 4096 --nocheck
+
+import __future__
+import sys
+from seek_common import *
+
+
+nruns = 3
+SDSgeom = 'rectangle'
+size = (4096, 4096)
+
+testBattery = dict()
+cn = "%s%sx%s" % (case_name, str(size[0]), str(size[1]))
+for p in range(max(1, minSdd), min(maxSdd, 13)):
+    test = dict()
+    test['nSDD'] = (2**(p - p // 2), 2**(p // 2))
+    test['nCoresPerSDD'] = 1
+    test['nThreads'] = 1
+    test['nSDS'] = 1
+    test['nCommonSDS'] = 0
+    testBattery.setdefault(cn, list()).append(test)
+
+battery = compileTestBattery([testBattery], SDSgeom, nruns)
+
+results = []
+for cn, test, perfList in collectTestBattery(engineOptionDict, battery):
+    initTimes = [perfs['initTime'] for perfs in perfList]
+    setupTimes = [perfs.get('setupTime', 0) for perfs in perfList]
+    results.append((cn, test['nSDD'][0] * test['nSDD'][1], np.median(initTimes), np.median(setupTimes), np.min(setupTimes)))
+
+print(COLOR_BLUE + "Init time (ms)" + COLOR_ENDC)
+print("%20s %6s %12s %12s %12s" % ('case', 'nSDD', 'init', 'setup', 'min setup'))
+for r in results:
+    print("%20s %6d %12.0f %12.0f %12.0f" % r)
@@ -10,6 +10,8 @@
 #include "timestamp/timestamp.hpp"
 #include "exception/exception.hpp"
 #include "IO.hpp"
+#include "SnapshotWriter.hpp"
+#include "CheckpointWriter.hpp"
 #include "engine.hpp"
 #ifndef SEQUENTIAL
 #include <mpi.h>
@@ -43,9 +45,11 @@ int Engine::main(int argc, char** argv) {
     bool outputpathSet = false;
     _testFlag = 0;
     _dryFlag = 0;
+    _restartFlag = 0;
     struct option long_options[] = {
         {"test", no_argument, nullptr, 't'},
         {"dry", no_argument, nullptr, 'd'},
+        {"restart", no_argument, nullptr, 'R'},
         {"rounding", required_argument, nullptr, 'r'},
         {"output", required_argument, nullptr, 'o'},
         {"input", required_argument, nullptr, 'i'},
@@ -56,7 +60,7 @@ int Engine::main(int argc, char** argv) {
     std::map<std::string, int> perfResults;
 
     int option_index = 0;
-    while ((flag = getopt_long(argc, argv, "tdr:i:o:h", long_options, &option_index)) != EOF) {
+    while ((flag = getopt_long(argc, argv, "tdRr:i:o:h", long_options, &option_index)) != EOF) {
         switch(flag){
             case 0:
                 //printf ("option %s", long_options[option_index].name);
@@ -72,6 +76,10 @@ int Engine::main(int argc, char** argv) {
                 _dryFlag = 1;
                 break;
 
+            case 'R':
+                _restartFlag = 1;
+                break;
+
             case 'r':
                 roundingmode.assign(optarg);
                 break;
@@ -88,6 +96,7 @@ int Engine::main(int argc, char** argv) {
             case 'h': default:
                 cout << "-i to define input file path" << endl;
                 cout << "-o to define output path" << endl;
+                cout << "-R to restart from the last checkpoint in the output path" << endl;
                 cout << "-h this menu" << endl;
                 cout << "Example:\n\t./scheme-debug-intel -i input.var -o /tmp\n";
                 return EXIT_SUCCESS;
@@ -220,6 +229,9 @@ int Engine::main(int argc, char** argv) {
 
         if (_dryFlag != 0)
             cout << "Dry flag is on." << endl;
+
+        if (_restartFlag != 0)
+            cout << "Restart flag is on." << endl;
         #endif
     }
 
@@ -243,9 +255,20 @@ int Engine::main(int argc, char** argv) {
         cout << result << Console::_normal << endl;
         return EXIT_FAILURE;
     }
+
+    if (_restartFlag != 0)
+        restart();
+    startWriters();
+
     #ifndef SEQUENTIAL
     MPI_Barrier(MPI_COMM_WORLD);
     #endif
+
+    // The setup of the slowest SDD.
+    int setupTime(_timerSetup.getTotalSteadyDuration());
+    #ifndef SEQUENTIAL
+    MPI_Reduce(_MPI_rank == 0 ? MPI_IN_PLACE : &setupTime, &setupTime, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+    #endif
     if (_MPI_rank == 0) {
 
         _timerGlobal.end();
@@ -253,6 +276,7 @@ int Engine::main(int argc, char** argv) {
         _timerGlobal.reportLast();
 
         perfResults["initTime"] = _timerGlobal.getLastSteadyDuration();
+        perfResults["setupTime"] = setupTime;
 
         cout << Console::_green;
         TimeStamp::printLocalTime();
@@ -273,6 +297,8 @@ int Engine::main(int argc, char** argv) {
         return EXIT_FAILURE;
     }
 
+    finishWriters();
+
     #ifndef SEQUENTIAL
     MPI_Barrier(MPI_COMM_WORLD);
     #endif
@@ -318,6 +344,173 @@ void Engine::setOptions(real T, real CFL, real gamma) {
     _gamma = gamma;
 }
 
+void Engine::setSnapshotOptions(unsigned int iterations, real interval) {
+
+    _snapshotIterations = iterations;
+    _snapshotInterval = interval;
+}
+
+void Engine::setCheckpointOptions(unsigned int iterations, unsigned int keep) {
+
+    if (keep < 2)
+        exitfail("checkpointKeep must be at least 2.");
+
+    _checkpointIterations = iterations;
+    _checkpointKeep = keep;
+}
+
+void Engine::initSnapshots(const Domain& domain, const std::vector<std::string>& quantityNames) {
+
+    _snapshotDomain = &domain;
+    _snapshotNames = quantityNames;
+}
+
+bool Engine::snapshotDue() const {
+
+    if (_snapshotWriter == nullptr)
+        return false;
+
+    return (_snapshotIterations > 0 && _nIterations % _snapshotIterations == 0)
+        || (_snapshotInterval > Number::zero && !(_t < _nextSnapshotTime));
+}
+
+void Engine::snapshot() {
+
+    if (!snapshotDue())
+        return;
+
+    while (_snapshotInterval > Number::zero && !(_t < _nextSnapshotTime))
+        _nextSnapshotTime = _nextSnapshotTime + _snapshotInterval;
+
+    _snapshotWriter->push(_snapshotCount++, _nIterations, _t);
+}
+
+void Engine::initCheckpoints(Domain& domain, const std::vector<real*>& reals) {
+
+    _checkpointDomain = &domain;
+    _checkpointReals = reals;
+}
+
+void Engine::loadQuantity(Domain& domain, const std::string& quantityName) {
+
+    if (_restartFlag != 0)
+        domain.addQuantity(quantityName);
+    else
+        IO::loadQuantity(_initpath, quantityName, domain);
+}
+
+void Engine::checkpoint() {
+
+    if (_checkpointWriter == nullptr || _nIterations % _checkpointIterations != 0)
+        return;
+
+    IO::CheckpointState state;
+    state.iteration = _nIterations;
+    state.reals = {_t, _nextSnapshotTime};
+    for (auto const& value: _checkpointReals)
+        state.reals.push_back(*value);
+    state.counters = {_snapshotCount};
+    state.timers = {_timerIteration.getSteadyTimeDeque(), _timerComputation.getSteadyTimeDeque()};
+
+    const unsigned int k((_nIterations / _checkpointIterations) % _checkpointKeep);
+    _checkpointWriter->push(checkpointFileName(k), state, *_checkpointDomain);
+}
+
+std::string Engine::checkpointFileName(unsigned int k) const {
+
+    std::ostringstream oss;
+    oss << _outputpath << "/sdd" << _checkpointDomain->getSDDconst().getId() << "/checkpoint-" << k << ".bin";
+    return oss.str();
+}
+
+void Engine::restart() {
+
+    if (_checkpointDomain == nullptr)
+        exitfail("No checkpoint in this scheme, it can't restart.");
+
+    // The iterations of the checkpoints of each SDD, 0 if missing: a SDD
+    // may have written a checkpoint the others didn't when stopped.
+    std::vector<unsigned int> iterations(_checkpointKeep, 0);
+    for (unsigned int k = 0; k < _checkpointKeep; ++k) {
+        if (IO::readCheckpointIteration(checkpointFileName(k), iterations[k]) != 0)
+            iterations[k] = 0;
+    }
+
+    #ifndef SEQUENTIAL
+    int nSDD(0);
+    MPI_Comm_size(MPI_COMM_WORLD, &nSDD);
+    std::vector<unsigned int> allIterations(_checkpointKeep * nSDD);
+    MPI_Allgather(iterations.data(), _checkpointKeep, MPI_UNSIGNED,
+            allIterations.data(), _checkpointKeep, MPI_UNSIGNED, MPI_COMM_WORLD);
+    #else
+    const int nSDD(1);
+    const std::vector<unsigned int>& allIterations(iterations);
+    #endif
+
+    unsigned int iteration(0);
+    for (auto const& candidate: iterations) {
+        if (candidate <= iteration)
+            continue;
+
+        bool everywhere(true);
+        for (int sdd = 0; sdd < nSDD && everywhere; ++sdd) {
+            auto first(allIterations.begin() + sdd * _checkpointKeep);
+            everywhere = (std::find(first, first + _checkpointKeep, candidate) != first + _checkpointKeep);
+        }
+        if (everywhere)
+            iteration = candidate;
+    }
+
+    if (iteration == 0)
+        exitfail("No checkpoint written by all the SDDs in: " + _outputpath);
+
+    const unsigned int k(std::find(iterations.begin(), iterations.end(), iteration) - iterations.begin());
+    IO::CheckpointState state;
+    if (IO::loadCheckpoint(checkpointFileName(k), state, *_checkpointDomain) != 0)
+        exitfail("Cannot load checkpoint file: " + checkpointFileName(k));
+
+    if (state.reals.size() != 2 + _checkpointReals.size() || state.counters.size() != 1 || state.timers.size() != 2)
+        exitfail("Checkpoint file of another scheme: " + checkpointFileName(k));
+
+    _nIterations = state.iteration;
+    _t = state.reals[0];
+    _nextSnapshotTime = state.reals[1];
+    for (size_t r = 0; r < _checkpointReals.size(); ++r)
+        *_checkpointReals[r] = state.reals[2 + r];
+    _snapshotCount = state.counters[0];
+    _timerIteration.setSteadyTimeDeque(state.timers[0]);
+    _timerComputation.setSteadyTimeDeque(state.timers[1]);
+
+    if (_MPI_rank == 0)
+        std::cout << "Restart from iteration " << _nIterations << "." << std::endl;
+}
+
+void Engine::startWriters() {
+
+    if (_dryFlag != 0)
+        return;
+
+    if (_snapshotDomain != nullptr && (_snapshotIterations > 0 || _snapshotInterval > Number::zero)) {
+        if (_restartFlag == 0)
+            _nextSnapshotTime = _t + _snapshotInterval;
+        _snapshotWriter = new SnapshotWriter(_outputpath, *_snapshotDomain, _snapshotNames, _restartFlag != 0);
+    }
+
+    if (_checkpointIterations > 0) {
+        if (_checkpointDomain == nullptr)
+            exitfail("No checkpoint in this scheme, checkpointIterations must not be set.");
+        _checkpointWriter = new CheckpointWriter();
+    }
+}
+
+void Engine::finishWriters() {
+
+    delete _snapshotWriter;
+    _snapshotWriter = nullptr;
+    delete _checkpointWriter;
+    _checkpointWriter = nullptr;
+}
+
 void Engine::updateDomainUmax() {
 
     #ifndef SEQUENTIAL
@@ -334,6 +527,29 @@ void Engine::updateDomainUmax() {
     #endif
 }
 
+void Engine::startDomainUmax() {
+
+    #ifndef SEQUENTIAL
+    _SDD_uxmax = *std::max_element(_SDS_uxmax.begin(), _SDS_uxmax.end());
+    _SDD_uymax = *std::max_element(_SDS_uymax.begin(), _SDS_uymax.end());
+    _SDD_umax[0] = _SDD_uxmax;
+    _SDD_umax[1] = _SDD_uymax;
+    MPI_Iallreduce(_SDD_umax, _Domain_umax, 2, MPI_REALTYPE, MPI_MAX, MPI_COMM_WORLD, &_umaxRequest);
+    #endif
+}
+
+void Engine::finishDomainUmax() {
+
+    #ifndef SEQUENTIAL
+    MPI_Wait(&_umaxRequest, MPI_STATUS_IGNORE);
+    _Domain_uxmax = _Domain_umax[0];
+    _Domain_uymax = _Domain_umax[1];
+    #else
+    _Domain_uxmax = *std::max_element(_SDS_uxmax.begin(), _SDS_uxmax.end());
+    _Domain_uymax = *std::max_element(_SDS_uymax.begin(), _SDS_uymax.end());
+    #endif
+}
+
 void Engine::updateDomainUxmax() {
 
     #ifndef SEQUENTIAL
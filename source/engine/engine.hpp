@@ -12,6 +12,10 @@
 #include "number/number.hpp"
 #include "timer/timer.hpp"
 
+class Domain;
+class SnapshotWriter;
+class CheckpointWriter;
+
 /*!
  * @brief base class used to program a numerical scheme
  */
@@ -54,18 +58,75 @@ class Engine {
      */
     void setOptions(real T, real CFL, real _gamma);
 
+    /*!
+     * @brief Set the periodic snapshots of the quantities (see
+     * initSnapshots), 0 to disable.
+     *
+     * @param iterations number of iterations between two snapshots
+     * @param interval simulated time between two snapshots
+     */
+    void setSnapshotOptions(unsigned int iterations, real interval);
+
+    /*!
+     * @brief Set the periodic checkpoints of the state (see
+     * initCheckpoints).
+     *
+     * @param iterations number of iterations between two checkpoints, 0 to
+     * disable
+     * @param keep number of checkpoint files written in turn, at least 2
+     */
+    void setCheckpointOptions(unsigned int iterations, unsigned int keep);
+
     void updateDomainUmax();
+
+    /*!
+     * @brief updateDomainUmax in two steps: the reduction of the maxima is
+     * posted by startDomainUmax and completed by finishDomainUmax, so that
+     * the computations which don't need them run meanwhile.
+     */
+    void startDomainUmax();
+    void finishDomainUmax();
+
     void updateDomainUxmax();
     void updateDomainUymax();
     real reduceMin(const real& v);
 
   protected:
     void printStatus(bool force = false);
+
+    /*!
+     * @brief Periodic snapshots of the quantities, written by a background
+     * thread (see SnapshotWriter). initSnapshots names the quantities, at
+     * the end of the init: the thread is started after the init when
+     * snapshots are set in scheme_info.dat. snapshot is called at the end
+     * of each iteration and copies the quantities when one is due
+     * (snapshotDue).
+     */
+    void initSnapshots(const Domain& domain, const std::vector<std::string>& quantityNames);
+    bool snapshotDue() const;
+    void snapshot();
+
+    /*!
+     * @brief Periodic checkpoints of the state, written by a background
+     * thread (see CheckpointWriter) in _outputpath/sddN/checkpoint-k.bin,
+     * k going round the checkpointKeep files.
+     *
+     * initCheckpoints is called at the end of the init with the members of
+     * the scheme to save, besides the quantities of the SDD, the time, the
+     * number of iterations and the timers. With the restart flag, they are
+     * then loaded from the last checkpoint written by all the SDDs, so
+     * loadQuantity only adds the quantities instead of reading their
+     * initial values. checkpoint is called at the end of each iteration.
+     */
+    void initCheckpoints(Domain& domain, const std::vector<real*>& reals);
+    void loadQuantity(Domain& domain, const std::string& quantityName);
+    void checkpoint();
     
     std::string _initpath;
     std::string _outputpath;
     int _testFlag;
     int _dryFlag;
+    int _restartFlag;
 
     real _t, _T;
     real _CFL;
@@ -76,6 +137,12 @@ class Engine {
     Timer _timerComputation;
     Timer _timerGlobal;
 
+    /*!
+     * building of the subdomains and of their communication maps, part of
+     * the init reported as setupTime
+     */
+    Timer _timerSetup;
+
     int _MPI_rank;
 
     std::vector<real> _SDS_uxmax;
@@ -87,6 +154,47 @@ class Engine {
     unsigned int _nIterations;
   private:
     int iPrintStatus = 0;
+
+    unsigned int _snapshotIterations = 0;
+    real _snapshotInterval = Number::zero;
+    real _nextSnapshotTime = Number::zero;
+    SnapshotWriter* _snapshotWriter = nullptr;
+    const Domain* _snapshotDomain = nullptr;
+    std::vector<std::string> _snapshotNames;
+    unsigned int _snapshotCount = 0;
+
+    unsigned int _checkpointIterations = 0;
+    unsigned int _checkpointKeep = 2;
+    CheckpointWriter* _checkpointWriter = nullptr;
+    Domain* _checkpointDomain = nullptr;
+    std::vector<real*> _checkpointReals;
+
+    /*!
+     * @brief Path of the checkpoint file of the SDD in the slot k.
+     */
+    std::string checkpointFileName(unsigned int k) const;
+
+    /*!
+     * @brief Loads the last checkpoint written by all the SDDs.
+     */
+    void restart();
+
+    /*!
+     * @brief Start the threads of the snapshots and checkpoints, after the
+     * init, and wait for the last files to be written, after the
+     * iterations.
+     */
+    void startWriters();
+    void finishWriters();
+
+    #ifndef SEQUENTIAL
+    /*!
+     * buffers and request of the reduction in flight (see startDomainUmax)
+     */
+    real _SDD_umax[2];
+    real _Domain_umax[2];
+    MPI_Request _umaxRequest = MPI_REQUEST_NULL;
+    #endif
 };
 
 #endif
@@ -0,0 +1,154 @@
+#ifndef BUFFEREDWRITER_HPP
+#define BUFFEREDWRITER_HPP
+
+/*!
+ * @file:
+ *
+ * @brief Double buffer written by a background thread
+ */
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*!
+ * @brief Writes buffers from a background thread while the next iterations
+ * are computed.
+ *
+ * A derived class fills the buffer returned by acquire and hands it to the
+ * thread with release; the thread calls writeBuffer on the buffers in the
+ * order they were released. There are two buffers: acquire only waits when
+ * both are still to be written.
+ * The derived class calls start at the end of its constructor and stop at
+ * the beginning of its destructor, so that writeBuffer is only called on a
+ * complete object.
+ */
+template<typename Buffer>
+class BufferedWriter {
+
+  public:
+
+    virtual ~BufferedWriter() {
+
+        stop();
+    }
+
+  protected:
+
+    BufferedWriter():
+        _fill(0), _stop(false) {
+
+        _busy[0] = _busy[1] = false;
+    }
+
+    /*!
+     * @brief Starts the thread
+     */
+    void start() {
+
+        _thread = std::thread(&BufferedWriter::write, this);
+    }
+
+    /*!
+     * @brief Waits for the buffers left to be written and stops the thread
+     */
+    void stop() {
+
+        if (!_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _condition.notify_all();
+        _thread.join();
+    }
+
+    /*!
+     * @brief Returns the buffer to fill, once written if the thread is late
+     */
+    Buffer& acquire() {
+
+        const unsigned int b(_fill);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [this, b] { return !_busy[b]; });
+        return _buffers[b];
+    }
+
+    /*!
+     * @brief Hands the buffer returned by acquire to the thread
+     */
+    void release() {
+
+        const unsigned int b(_fill);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _busy[b] = true;
+            _queue.push_back(b);
+        }
+        _condition.notify_all();
+        _fill = 1 - b;
+    }
+
+    /*!
+     * @brief Writes a buffer, called by the thread
+     */
+    virtual void writeBuffer(const Buffer& buffer) = 0;
+
+    Buffer _buffers[2];
+
+  private:
+
+    /*!
+     * @brief Loop of the thread: writes the buffers in the order they were
+     * released.
+     */
+    void write() {
+
+        while (true) {
+            unsigned int b;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this] { return _stop || !_queue.empty(); });
+
+                // Stopped, and everything is written.
+                if (_queue.empty())
+                    return;
+
+                b = _queue.front();
+                _queue.pop_front();
+            }
+
+            writeBuffer(_buffers[b]);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _busy[b] = false;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    /*!
+     * true while a buffer is released and not written yet
+     */
+    bool _busy[2];
+
+    /*!
+     * buffers to write, in order
+     */
+    std::deque<unsigned int> _queue;
+
+    /*!
+     * buffer filled by the next acquire
+     */
+    unsigned int _fill;
+
+    bool _stop;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::thread _thread;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "CheckpointWriter.hpp"
+#include "exception/exception.hpp"
+
+CheckpointWriter::CheckpointWriter() {
+
+    start();
+}
+
+CheckpointWriter::~CheckpointWriter() {
+
+    stop();
+}
+
+void CheckpointWriter::push(const std::string& fileName, const IO::CheckpointState& state, const Domain& domain) {
+
+    Checkpoint& checkpoint(acquire());
+    checkpoint.fileName = fileName;
+    IO::serializeCheckpoint(state, domain, checkpoint.data);
+
+    release();
+}
+
+void CheckpointWriter::writeBuffer(const Checkpoint& checkpoint) {
+
+    if (IO::writeCheckpoint(checkpoint.fileName, checkpoint.data) != 0)
+        exitfail("Cannot write checkpoint file: " + checkpoint.fileName);
+}
@@ -0,0 +1,60 @@
+#ifndef CHECKPOINTWRITER_HPP
+#define CHECKPOINTWRITER_HPP
+
+/*!
+ * @file:
+ *
+ * @brief Checkpoints of the engine state, written by a background thread
+ */
+#include <string>
+#include <vector>
+
+#include "IO.hpp"
+#include "BufferedWriter.hpp"
+
+/*!
+ * @brief Serialized checkpoint and the file it goes to
+ */
+struct Checkpoint {
+    std::string fileName;
+    std::vector<char> data;
+};
+
+/*!
+ * @brief Writes the checkpoints of a SDD during the iterations.
+ *
+ * push serializes the state and the quantities (see
+ * IO::serializeCheckpoint) in a buffer written by the thread of
+ * BufferedWriter while the next iterations are computed (see
+ * IO::writeCheckpoint).
+ */
+class CheckpointWriter: public BufferedWriter<Checkpoint> {
+
+  public:
+
+    /*!
+     * @brief Constructor, starts the thread
+     */
+    CheckpointWriter();
+
+    /*!
+     * @brief Destructor, waits for the checkpoints left to be written
+     */
+    ~CheckpointWriter();
+
+    /*!
+     * @brief Copies the state and the quantities of the SDD and hands them
+     * to the thread.
+     *
+     * @param fileName path of the checkpoint file
+     * @param state state of the engine
+     * @param domain domain, whose SDD quantities are copied
+     */
+    void push(const std::string& fileName, const IO::CheckpointState& state, const Domain& domain);
+
+  private:
+
+    void writeBuffer(const Checkpoint& checkpoint) override;
+};
+
+#endif
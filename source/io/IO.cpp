@@ -4,16 +4,211 @@
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <cfloat>
+#include <cfenv>
+#include <cstring>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+    const char quantityMagic[8] = {'V', 'A', 'R', 'I', 'A', 'N', 'T', 'Q'};
+    const char checkpointMagic[8] = {'V', 'A', 'R', 'I', 'A', 'N', 'T', 'C'};
+
+    /*!
+     * type and bits of the significand of the values written in the binary
+     * files: the floats holding the weak floats, real otherwise.
+     */
+    #if defined(PRECISION_WEAK_FLOAT)
+    typedef float fileReal;
+    const std::uint32_t fileRealPrecision = FLT_MANT_DIG;
+    #elif defined(PRECISION_FLOAT)
+    typedef real fileReal;
+    const std::uint32_t fileRealPrecision = FLT_MANT_DIG;
+    #elif defined(PRECISION_DOUBLE)
+    typedef real fileReal;
+    const std::uint32_t fileRealPrecision = DBL_MANT_DIG;
+    #elif defined(PRECISION_LONG_DOUBLE)
+    typedef real fileReal;
+    const std::uint32_t fileRealPrecision = LDBL_MANT_DIG;
+    #elif defined(PRECISION_QUAD)
+    typedef real fileReal;
+    const std::uint32_t fileRealPrecision = FLT128_MANT_DIG;
+    #endif
+
+    template<typename S> inline real toReal(const S& value) {
+        #if defined(PRECISION_WEAK_FLOAT)
+        return real(static_cast<float>(value));
+        #else
+        return static_cast<real>(value);
+        #endif
+    }
+
+    /*!
+     * @brief Copies the values of type S following the header, row by row.
+     */
+    template<typename S>
+    void copyRows(const char* data, const IO::QuantityHeader& header, Quantity<real>& quantity) {
+        const S* values = reinterpret_cast<const S*>(data);
+        std::vector<real> row(std::is_same<S, real>::value ? 0 : header.sizeX);
+        for (unsigned int j = 0; j < header.sizeY; ++j) {
+            const S* fileRow = values + size_t(j) * header.sizeX;
+            if (std::is_same<S, real>::value) {
+                quantity.setRange(reinterpret_cast<const real*>(fileRow), header.sizeX, 0, j);
+                continue;
+            }
+
+            for (unsigned int i = 0; i < header.sizeX; ++i)
+                row[i] = toReal(fileRow[i]);
+            quantity.setRange(row.data(), header.sizeX, 0, j);
+        }
+    }
+
+    /*!
+     * @brief Header of a file of sizeX * sizeY values of type fileReal.
+     */
+    IO::QuantityHeader fileHeader(unsigned int sizeX, unsigned int sizeY) {
+        IO::QuantityHeader header;
+        std::memcpy(header.magic, quantityMagic, sizeof(quantityMagic));
+        header.valueSize = sizeof(fileReal);
+        header.precision = fileRealPrecision;
+        header.rounding = std::fegetround();
+        header.sizeX = sizeX;
+        header.sizeY = sizeY;
+        header.layout = 0;
+        return header;
+    }
+
+    /*!
+     * @brief Writes the buffer in a new file, in one pwrite, and
+     * synchronises it on the disk when sync is true.
+     */
+    int writeFile(const std::string& fileName, const std::vector<char>& buffer, bool sync = false) {
+        const int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            std::cerr << "Failed to open file: " << fileName << std::endl;
+            return 1;
+        }
+
+        // pwrite may write less than asked, e.g. when interrupted.
+        size_t written = 0;
+        while (written < buffer.size()) {
+            const ssize_t n = pwrite(fd, buffer.data() + written, buffer.size() - written, written);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                close(fd);
+                exitfail("Failed to write binary quantity file: " + fileName);
+            }
+            written += n;
+        }
+
+        if (sync && fsync(fd) != 0)
+            exitfail("Failed to synchronise file: " + fileName);
+        close(fd);
+        return 0;
+    }
+
+    /*!
+     * @brief Reads the fields of a checkpoint one after the other.
+     */
+    class CheckpointReader {
+      public:
+        CheckpointReader(const char* data, size_t size, const std::string& fileName):
+            _data(data), _size(size), _offset(0), _fileName(fileName) {}
+
+        void read(void* value, size_t size) {
+            if (_offset + size > _size)
+                exitfail("Truncated checkpoint file: " + _fileName);
+            std::memcpy(value, _data + _offset, size);
+            _offset += size;
+        }
+
+        template<typename S> S read() {
+            S value;
+            read(&value, sizeof(S));
+            return value;
+        }
+
+      private:
+        const char* _data;
+        size_t _size;
+        size_t _offset;
+        std::string _fileName;
+    };
+
+    /*!
+     * @brief Marks the axes along which the boundary conditions of a SDD are
+     * periodic. Nothing is read if the SDD does not exist.
+     */
+    void readPeriodicSides(const std::string& directory, int SDDid, const Domain& domain, int periodic[2]) {
+        const std::string sddPath(directory + "/sdd" + std::to_string(SDDid));
+        std::ifstream info(sddPath + "/sdd.dat", std::ios::in);
+        int BL_X(0), BL_Y(0);
+        if (!(info >> BL_X >> BL_Y))
+            return;
+
+        std::ifstream ifs(sddPath + "/bc.dat", std::ios::in);
+        std::string tmpStr;
+        while (std::getline(ifs, tmpStr)) {
+            std::istringstream iss(tmpStr);
+            unsigned int uid;
+            int iCoord, jCoord;
+            char BCtype;
+            if (!(iss >> uid >> iCoord >> jCoord >> BCtype) || BCtype != 'P')
+                continue;
+
+            const int side(domain.getBoundarySide(std::make_pair(iCoord + BL_X, jCoord + BL_Y)));
+            if (side == LEFT || side == RIGHT)
+                periodic[0] = 1;
+            else if (side == BOTTOM || side == TOP)
+                periodic[1] = 1;
+        }
+    }
+
+    /*!
+     * @brief Copies the interior of a SDD, row by row, in values.
+     */
+    void gatherRows(const Quantity<real>& quantity, unsigned int sizeX, unsigned int sizeY, fileReal* values) {
+        std::vector<real> row(std::is_same<fileReal, real>::value ? 0 : sizeX);
+        for (unsigned int j = 0; j < sizeY; ++j) {
+            fileReal* fileRow = values + size_t(j) * sizeX;
+            if (std::is_same<fileReal, real>::value) {
+                quantity.getRange(reinterpret_cast<real*>(fileRow), sizeX, 0, j);
+                continue;
+            }
+
+            quantity.getRange(row.data(), sizeX, 0, j);
+            for (unsigned int i = 0; i < sizeX; ++i)
+                fileRow[i] = static_cast<fileReal>(row[i]);
+        }
+    }
+}
 
 int IO::loadSDDInfo(std::string directory, Domain& domain) {
 
+    // With the neighbourhood collective, the processes are placed on the
+    // topology used by the exchange, periodic where the boundary conditions
+    // are: the process of rank r reads them in sddr before being placed.
+    int periodic[2] = {0, 0};
     #ifndef SEQUENTIAL
-    int SDDid;
-    MPI_Comm_rank(MPI_COMM_WORLD, &SDDid);
-    #else
-    int SDDid = 0;
+    if (domain.getExecOption("haloExchange", "packed") == "neighbour") {
+        int rank(0);
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        readPeriodicSides(directory, rank, domain, periodic);
+        MPI_Allreduce(MPI_IN_PLACE, periodic, 2, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    }
     #endif
 
+    const int SDDid(domain.placeSDD(periodic[0], periodic[1]));
+
     std::ostringstream oss;
     oss << SDDid;
 
@@ -74,9 +269,32 @@ int IO::loadSchemeInfo(std::string directory, Engine& engine) {
     real CFL; stor(tmpStr, CFL);
     std::getline(ifs, tmpStr);
     real gamma; stor(tmpStr, gamma);
+
+    // Optional name=value options on the next line.
+    unsigned int snapshotIterations(0);
+    real snapshotInterval(Number::zero);
+    unsigned int checkpointIterations(0);
+    unsigned int checkpointKeep(2);
+    while (ifs >> tmpStr) {
+        const size_t equal(tmpStr.find('='));
+        const std::string name(tmpStr.substr(0, equal));
+        const std::string value(equal == std::string::npos ? "" : tmpStr.substr(equal + 1));
+        if (name == "snapshotIterations")
+            snapshotIterations = std::stoul(value);
+        else if (name == "snapshotInterval")
+            stor(value, snapshotInterval);
+        else if (name == "checkpointIterations")
+            checkpointIterations = std::stoul(value);
+        else if (name == "checkpointKeep")
+            checkpointKeep = std::stoul(value);
+        else
+            exitfail("Unknown scheme option: " + tmpStr);
+    }
     ifs.close();
 
     engine.setOptions(T, CFL, gamma);
+    engine.setSnapshotOptions(snapshotIterations, snapshotInterval);
+    engine.setCheckpointOptions(checkpointIterations, checkpointKeep);
 
     return 0;
 }
@@ -104,10 +322,22 @@ int IO::loadExecOptions(std::string directory, Domain& domain) {
     unsigned int nThreads = std::stoi(tmpStr);
     std::getline(ifs, tmpStr, ' ');
     unsigned int nCommonSDS = std::stoi(tmpStr);
-    ifs.close();
 
     domain.setOptions(nSDD, nSDD_X, nSDD_Y, nSDS, SDSgeom, nThreads, nCommonSDS);
 
+    // Then nCoresPerSDD, only used by the launcher, and the optional
+    // options written as name=value.
+    std::getline(ifs, tmpStr);
+    std::istringstream iss(tmpStr);
+    iss >> tmpStr;
+    while (iss >> tmpStr) {
+        size_t pos = tmpStr.find('=');
+        if (pos == std::string::npos)
+            exitfail("Exec option not written as name=value: " + tmpStr);
+        domain.setExecOption(tmpStr.substr(0, pos), tmpStr.substr(pos + 1));
+    }
+    ifs.close();
+
     return 0;
 }
 
@@ -118,7 +348,11 @@ int IO::loadQuantity(std::string directory, std::string quantityName, Domain& do
     std::ostringstream oss;
     oss << sdd.getId();
 
-    std::ifstream ifs(directory + "/sdd" + oss.str() + "/" + quantityName + ".dat", std::ios::in);
+    const std::string fileName(directory + "/sdd" + oss.str() + "/" + quantityName);
+    if (loadBinaryQuantity(fileName + ".bin", *sdd.getQuantity(quantityName), sdd.getSizeX(), sdd.getSizeY()) == 0)
+        return 0;
+
+    std::ifstream ifs(fileName + ".dat", std::ios::in);
 
     // If the file does not exist, SDD quantity will be initialized to 0.
     if (!ifs.is_open())
@@ -144,6 +378,51 @@ int IO::loadQuantity(std::string directory, std::string quantityName, Domain& do
     return 0;
 }
 
+int IO::loadBinaryQuantity(const std::string& fileName, Quantity<real>& quantity, unsigned int sizeX, unsigned int sizeY) {
+
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || size_t(fileStat.st_size) < sizeof(QuantityHeader))
+        exitfail("Bad binary quantity file: " + fileName);
+
+    void* map = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        exitfail("Cannot map binary quantity file: " + fileName);
+    madvise(map, fileStat.st_size, MADV_SEQUENTIAL);
+
+    QuantityHeader header;
+    std::memcpy(&header, map, sizeof(QuantityHeader));
+    if (std::memcmp(header.magic, quantityMagic, sizeof(quantityMagic)) != 0)
+        exitfail("Bad binary quantity file: " + fileName);
+    if (header.sizeX != sizeX || header.sizeY != sizeY)
+        exitfail("Binary quantity file of another SDD size: " + fileName);
+    if (header.layout != 0)
+        exitfail("Unknown layout of binary quantity file: " + fileName);
+    if (size_t(fileStat.st_size) < sizeof(QuantityHeader) + size_t(header.valueSize) * sizeX * sizeY)
+        exitfail("Truncated binary quantity file: " + fileName);
+
+    const char* data = static_cast<const char*>(map) + sizeof(QuantityHeader);
+    if (header.valueSize == sizeof(float) && header.precision == FLT_MANT_DIG)
+        copyRows<float>(data, header, quantity);
+    else if (header.valueSize == sizeof(double) && header.precision == DBL_MANT_DIG)
+        copyRows<double>(data, header, quantity);
+    else if (header.valueSize == sizeof(long double) && header.precision == LDBL_MANT_DIG)
+        copyRows<long double>(data, header, quantity);
+    #if defined(PRECISION_QUAD)
+    else if (header.valueSize == sizeof(__float128) && header.precision == FLT128_MANT_DIG)
+        copyRows<__float128>(data, header, quantity);
+    #endif
+    else
+        exitfail("Unsupported precision of binary quantity file: " + fileName);
+
+    munmap(map, fileStat.st_size);
+    return 0;
+}
+
 int IO::loadBoundaryConditions(std::string directory, Domain& domain) {
 
     SDDistributed& sdd = domain.getSDD();
@@ -186,9 +465,21 @@ int IO::loadBoundaryConditions(std::string directory, Domain& domain) {
 int IO::writeQuantity(std::string directory, std::string quantityName, const Domain& domain) {
 
     const SDDistributed& sdd = domain.getSDDconst();
+    const Quantity<real>& quantity(*sdd.getQuantity(quantityName));
+
+    const std::string output(domain.getExecOption("output", "text"));
+    if (output == "shared")
+        return writeSharedQuantity(directory + "/" + quantityName + ".bin", quantity, domain);
 
     std::ostringstream oss;
-    oss << directory << "/sdd" << sdd.getId() << "/" << quantityName << ".dat";
+    oss << directory << "/sdd" << sdd.getId() << "/" << quantityName;
+
+    if (output == "binary")
+        return writeBinaryQuantity(oss.str() + ".bin", quantity, sdd.getSizeX(), sdd.getSizeY());
+    if (output != "text")
+        exitfail("Unknown output: " + output);
+
+    oss << ".dat";
     std::ofstream ofs(oss.str(), std::ios::out);
     if (!ofs) {
         std::cerr << "Failed to open file: " << oss.str() << std::endl;
@@ -198,7 +489,7 @@ int IO::writeQuantity(std::string directory, std::string quantityName, const Dom
     ofs << std::setprecision(Number::max_digits10);
     for (unsigned int i = 0; i < sdd.getSizeX(); ++i) {
         for (unsigned int j = 0; j < sdd.getSizeY(); ++j) {
-            ofs << i << " " << j << " " << sdd.getValue(quantityName, i, j) << std::endl;
+            ofs << i << " " << j << " " << quantity.get(0, i, j) << '\n';
         }
     }
 
@@ -206,6 +497,231 @@ int IO::writeQuantity(std::string directory, std::string quantityName, const Dom
     return 0;
 }
 
+int IO::writeBinaryQuantity(const std::string& fileName, const Quantity<real>& quantity, unsigned int sizeX, unsigned int sizeY) {
+
+    // The header and the values, row by row, in one buffer.
+    const size_t fileSize = sizeof(QuantityHeader) + sizeof(fileReal) * sizeX * sizeY;
+    std::vector<char> buffer(fileSize);
+    const QuantityHeader header(fileHeader(sizeX, sizeY));
+    std::memcpy(buffer.data(), &header, sizeof(QuantityHeader));
+    gatherRows(quantity, sizeX, sizeY, reinterpret_cast<fileReal*>(buffer.data() + sizeof(QuantityHeader)));
+
+    return writeFile(fileName, buffer);
+}
+
+int IO::writeBinaryQuantity(const std::string& fileName, const real* values, unsigned int sizeX, unsigned int sizeY) {
+
+    const size_t fileSize = sizeof(QuantityHeader) + sizeof(fileReal) * sizeX * sizeY;
+    std::vector<char> buffer(fileSize);
+    const QuantityHeader header(fileHeader(sizeX, sizeY));
+    std::memcpy(buffer.data(), &header, sizeof(QuantityHeader));
+    fileReal* fileValues = reinterpret_cast<fileReal*>(buffer.data() + sizeof(QuantityHeader));
+    for (size_t k = 0; k < size_t(sizeX) * sizeY; ++k)
+        fileValues[k] = static_cast<fileReal>(values[k]);
+
+    return writeFile(fileName, buffer);
+}
+
+int IO::writeSharedQuantity(const std::string& fileName, const Quantity<real>& quantity, const Domain& domain) {
+
+    const SDDistributed& sdd = domain.getSDDconst();
+
+    #ifdef SEQUENTIAL
+    // The only SDD is the domain.
+    return writeBinaryQuantity(fileName, quantity, sdd.getSizeX(), sdd.getSizeY());
+    #else
+    std::vector<fileReal> values(size_t(sdd.getSizeX()) * sdd.getSizeY());
+    gatherRows(quantity, sdd.getSizeX(), sdd.getSizeY(), values.data());
+
+    MPI_File file;
+    if (MPI_File_open(MPI_COMM_WORLD, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file) != MPI_SUCCESS)
+        exitfail("Failed to open shared quantity file: " + fileName);
+    MPI_File_set_size(file, 0);
+
+    if (sdd.getId() == 0) {
+        const QuantityHeader header(fileHeader(domain.getSizeX(), domain.getSizeY()));
+        MPI_File_write_at(file, 0, &header, sizeof(QuantityHeader), MPI_BYTE, MPI_STATUS_IGNORE);
+    }
+
+    // The file seen by the SDD is its block in the values of the domain.
+    MPI_Datatype value;
+    MPI_Type_contiguous(sizeof(fileReal), MPI_BYTE, &value);
+    MPI_Type_commit(&value);
+
+    const std::pair<int, int> BL(domain.getBLOfSDD(sdd.getId()));
+    const int sizes[2] = {int(domain.getSizeY()), int(domain.getSizeX())};
+    const int subsizes[2] = {int(sdd.getSizeY()), int(sdd.getSizeX())};
+    const int starts[2] = {BL.second, BL.first};
+    MPI_Datatype block;
+    MPI_Type_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, value, &block);
+    MPI_Type_commit(&block);
+
+    MPI_File_set_view(file, sizeof(QuantityHeader), value, block, "native", MPI_INFO_NULL);
+    if (MPI_File_write_all(file, values.data(), values.size(), value, MPI_STATUS_IGNORE) != MPI_SUCCESS)
+        exitfail("Failed to write shared quantity file: " + fileName);
+
+    MPI_File_close(&file);
+    MPI_Type_free(&block);
+    MPI_Type_free(&value);
+    return 0;
+    #endif
+}
+
+void IO::serializeCheckpoint(const CheckpointState& state, const Domain& domain, std::vector<char>& buffer) {
+
+    const SDDistributed& sdd = domain.getSDDconst();
+    const std::vector<std::string> names(sdd.getQuantityNames());
+
+    size_t size = sizeof(CheckpointHeader) + sizeof(real) * state.reals.size()
+        + sizeof(std::uint32_t) * state.counters.size();
+    for (auto const& timer: state.timers)
+        size += sizeof(std::uint64_t) * (1 + timer.size());
+    for (auto const& name: names)
+        size += 3 * sizeof(std::uint32_t) + name.size() + 2 * sizeof(real) * sdd.getQuantity(name)->getSize();
+    buffer.resize(size);
+
+    char* cursor = buffer.data();
+    auto append = [&cursor](const void* value, size_t n) {
+        std::memcpy(cursor, value, n);
+        cursor += n;
+    };
+
+    CheckpointHeader header;
+    std::memcpy(header.magic, checkpointMagic, sizeof(checkpointMagic));
+    header.valueSize = sizeof(real);
+    header.sddId = sdd.getId();
+    header.iteration = state.iteration;
+    header.nReals = state.reals.size();
+    header.nCounters = state.counters.size();
+    header.nTimers = state.timers.size();
+    header.nQuantities = names.size();
+    append(&header, sizeof(CheckpointHeader));
+
+    append(state.reals.data(), sizeof(real) * state.reals.size());
+    append(state.counters.data(), sizeof(std::uint32_t) * state.counters.size());
+    for (auto const& timer: state.timers) {
+        const std::uint64_t n(timer.size());
+        append(&n, sizeof(std::uint64_t));
+        for (auto const& duration: timer) {
+            const std::uint64_t d(duration);
+            append(&d, sizeof(std::uint64_t));
+        }
+    }
+
+    std::vector<real> values;
+    for (auto const& name: names) {
+        const Quantity<real>& quantity(*sdd.getQuantity(name));
+        const std::uint32_t nameSize(name.size());
+        const std::uint32_t currentPrev(quantity.currentPrev());
+        const std::uint32_t quantitySize(quantity.getSize());
+        append(&nameSize, sizeof(std::uint32_t));
+        append(name.data(), name.size());
+        append(&currentPrev, sizeof(std::uint32_t));
+        append(&quantitySize, sizeof(std::uint32_t));
+
+        // The arrays are copied as they are, through an aligned vector: the
+        // cursor is not aligned for real after the names.
+        values.resize(quantitySize);
+        for (unsigned int n = 0; n < 2; ++n) {
+            quantity.getArray(values.data(), n);
+            append(values.data(), sizeof(real) * quantitySize);
+        }
+    }
+}
+
+int IO::writeCheckpoint(const std::string& fileName, const std::vector<char>& buffer) {
+
+    const std::string tmpFileName(fileName + ".tmp");
+    if (writeFile(tmpFileName, buffer, true) != 0)
+        return 1;
+
+    if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+        exitfail("Failed to rename checkpoint file: " + tmpFileName);
+    return 0;
+}
+
+int IO::readCheckpointIteration(const std::string& fileName, unsigned int& iteration) {
+
+    std::ifstream ifs(fileName, std::ios::in | std::ios::binary);
+    CheckpointHeader header;
+    if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(CheckpointHeader)))
+        return -1;
+    if (std::memcmp(header.magic, checkpointMagic, sizeof(checkpointMagic)) != 0 || header.valueSize != sizeof(real))
+        return -1;
+
+    iteration = header.iteration;
+    return 0;
+}
+
+int IO::loadCheckpoint(const std::string& fileName, CheckpointState& state, Domain& domain) {
+
+    SDDistributed& sdd = domain.getSDD();
+
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+        exitfail("Bad checkpoint file: " + fileName);
+
+    void* map = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        exitfail("Cannot map checkpoint file: " + fileName);
+    madvise(map, fileStat.st_size, MADV_SEQUENTIAL);
+
+    CheckpointReader reader(static_cast<const char*>(map), fileStat.st_size, fileName);
+    const CheckpointHeader header(reader.read<CheckpointHeader>());
+    if (std::memcmp(header.magic, checkpointMagic, sizeof(checkpointMagic)) != 0 || header.valueSize != sizeof(real))
+        exitfail("Bad checkpoint file: " + fileName);
+    if (header.sddId != sdd.getId())
+        exitfail("Checkpoint file of another SDD: " + fileName);
+    if (header.nQuantities != sdd.getQuantityNames().size())
+        exitfail("Checkpoint file with other quantities: " + fileName);
+
+    state.iteration = header.iteration;
+    state.reals.resize(header.nReals);
+    reader.read(state.reals.data(), sizeof(real) * header.nReals);
+    state.counters.resize(header.nCounters);
+    reader.read(state.counters.data(), sizeof(std::uint32_t) * header.nCounters);
+    state.timers.assign(header.nTimers, std::deque<unsigned long int>());
+    for (auto& timer: state.timers) {
+        const std::uint64_t n(reader.read<std::uint64_t>());
+        for (std::uint64_t k = 0; k < n; ++k)
+            timer.push_back(reader.read<std::uint64_t>());
+    }
+
+    std::vector<real> values;
+    for (unsigned int q = 0; q < header.nQuantities; ++q) {
+        std::string name(reader.read<std::uint32_t>(), ' ');
+        reader.read(&name[0], name.size());
+        const std::uint32_t currentPrev(reader.read<std::uint32_t>());
+        const std::uint32_t quantitySize(reader.read<std::uint32_t>());
+
+        const std::vector<std::string> names(sdd.getQuantityNames());
+        if (std::find(names.begin(), names.end(), name) == names.end())
+            exitfail("Unknown quantity " + name + " in checkpoint file: " + fileName);
+        Quantity<real>& quantity(*sdd.getQuantity(name));
+        if (quantitySize != quantity.getSize())
+            exitfail("Checkpoint file of another SDD size: " + fileName);
+
+        // The arrays are restored in the same order, so that the buffers
+        // used by the communications are the same.
+        if (int(currentPrev) != quantity.currentPrev())
+            quantity.switchPrevNext();
+
+        values.resize(quantitySize);
+        for (unsigned int n = 0; n < 2; ++n) {
+            reader.read(values.data(), sizeof(real) * quantitySize);
+            quantity.setArray(values.data(), n);
+        }
+    }
+
+    munmap(map, fileStat.st_size);
+    return 0;
+}
+
 int IO::writePerfResults(std::string directory, const std::map<std::string, int>& results) {
 
     std::ofstream ofs(directory + "/perfs.dat");
@@ -255,7 +771,7 @@ int IO::writeVariantInfo(std::string directory, const Domain& domain) {
     ofs << domain.getNumberSDD() << " " << domain.getNumberSDD_X() << " " << domain.getNumberSDD_Y() << std::endl;
     ofs << domain.getNumberNeighbourSDDs() << " " << domain.getNumberPhysicalCells() << " " << domain.getNumberOverlapCells() << " " << domain.getNumberBoundaryCells() << std::endl;
     ofs << domain.getNumberSDS() << " " << domain.getSDSGeometry() << " " << domain.getNumberThreads() << " " << domain.getNumberCommonSDS() << std::endl;
-    ofs << "free_stack" << " " << "SoA" << std::endl;
+    ofs << "free_stack" << " " << sdd.getLayout() << std::endl;
     ofs.close();
     return 0;
 }
@@ -12,6 +12,8 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <cstdint>
+#include <deque>
 
 #include "Domain.hpp"
 #include "SDDistributed.hpp"
@@ -26,6 +28,54 @@ void stor(std::string tmpStr, long double& target);
  */
 namespace IO {
 
+    /*!
+     * @brief Header of the binary files of quantities (sddN/quantityName.bin).
+     *
+     * It is followed by the sizeX * sizeY values of the SDD in row-major
+     * order (x first), in the byte order of the machine.
+     */
+    struct QuantityHeader {
+        char magic[8];              //!< "VARIANTQ"
+        std::uint32_t valueSize;    //!< bytes of a value
+        std::uint32_t precision;    //!< bits of the significand of a value
+        std::int32_t rounding;      //!< rounding mode of the writer (fenv.h), for information
+        std::uint32_t sizeX;
+        std::uint32_t sizeY;
+        std::uint32_t layout;       //!< 0: row-major
+    };
+
+    /*!
+     * @brief Header of the checkpoint files of the SDDs
+     * (sddN/checkpoint-k.bin, see Engine::checkpoint).
+     *
+     * It is followed by nReals reals, nCounters uint32, nTimers timers (the
+     * number of durations then the durations, as uint64) and nQuantities
+     * quantities (length of the name, name, currentPrev, size, then the
+     * current and the next arrays as uint32 and reals), in the byte order of
+     * the machine.
+     */
+    struct CheckpointHeader {
+        char magic[8];              //!< "VARIANTC"
+        std::uint32_t valueSize;    //!< bytes of a real
+        std::uint32_t sddId;
+        std::uint32_t iteration;
+        std::uint32_t nReals;
+        std::uint32_t nCounters;
+        std::uint32_t nTimers;
+        std::uint32_t nQuantities;
+    };
+
+    /*!
+     * @brief State of the engine saved with the quantities of the SDD in a
+     * checkpoint.
+     */
+    struct CheckpointState {
+        unsigned int iteration;
+        std::vector<real> reals;
+        std::vector<std::uint32_t> counters;
+        std::vector< std::deque<unsigned long int> > timers;
+    };
+
     /*!
      * @brief Loads domain info and writes all necessary
      *
@@ -43,6 +93,9 @@ namespace IO {
      * Loaded parameters are:
      *  - final time T
      *  - CFL condition
+     *  - optional name=value options on the next line: snapshotIterations
+     *    and snapshotInterval (see Engine::initSnapshots), checkpointIterations
+     *    and checkpointKeep (see Engine::initCheckpoints)
      *
      * @param directory input folder
      * @param engine scheme engine
@@ -58,6 +111,7 @@ namespace IO {
      *  - number of SDDs
      *  - number of SDSs
      *  - SDS geometry
+     *  - optional name=value options (see Domain::setExecOption)
      *
      * @param directory input folder
      * @param domain domain
@@ -79,7 +133,9 @@ namespace IO {
     int loadSDDInfo(std::string directory, Domain& domain);
 
     /*!
-     * @brief Loads quantity data from file directory/quantityName.dat
+     * @brief Loads quantity data from file directory/sddN/quantityName.bin
+     * (see loadBinaryQuantity), or from the text file
+     * directory/sddN/quantityName.dat if there is no binary file.
      *
      * @param directory input folder
      * @param quantityName string name of quantity to be written
@@ -89,6 +145,21 @@ namespace IO {
             std::string quantityName,
             Domain& domain);
 
+    /*!
+     * @brief Loads the interior of a SDD from a binary file (see
+     * QuantityHeader): the file is mapped in memory and copied row by row
+     * in the quantity. Values of another precision are converted.
+     *
+     * @param fileName path of the file
+     * @param quantity quantity of the SDD
+     * @param sizeX, sizeY size of the SDD
+     *
+     * @return 0 if loading succeeded, -1 if the file does not exist
+     */
+    int loadBinaryQuantity(const std::string& fileName,
+            Quantity<real>& quantity,
+            unsigned int sizeX, unsigned int sizeY);
+
     /*!
      * @brief Loads boundary conditions
      *
@@ -101,6 +172,11 @@ namespace IO {
     /*!
      * @brief Writes quantity data into output file
      *
+     * The file is directory/sddN/quantityName.dat, a text file, or
+     * directory/sddN/quantityName.bin with the exec option output=binary
+     * (see writeBinaryQuantity). With output=shared, all the SDDs write in
+     * directory/quantityName.bin (see writeSharedQuantity).
+     *
      * @param directory destination folder
      * @param quantityName  name of the quantity to output
      * @param domain  domain data
@@ -109,6 +185,81 @@ namespace IO {
      */
     int writeQuantity(std::string directory, std::string quantityName, const Domain& domain);
 
+    /*!
+     * @brief Writes the interior of a SDD in a binary file (see
+     * QuantityHeader), which can be read by loadBinaryQuantity: the values
+     * are gathered row by row in a buffer written in one pwrite.
+     *
+     * @param fileName path of the file
+     * @param quantity quantity of the SDD
+     * @param sizeX, sizeY size of the SDD
+     *
+     * @return 0 if writing succeeded, 1 if the file can't be opened
+     */
+    int writeBinaryQuantity(const std::string& fileName,
+            const Quantity<real>& quantity,
+            unsigned int sizeX, unsigned int sizeY);
+
+    /*!
+     * @brief Writes sizeX * sizeY values, given in row-major order, in a
+     * binary file (see writeBinaryQuantity).
+     */
+    int writeBinaryQuantity(const std::string& fileName,
+            const real* values,
+            unsigned int sizeX, unsigned int sizeY);
+
+    /*!
+     * @brief Writes the quantity of the whole domain in one binary file
+     * (see QuantityHeader) with MPI-IO: each SDD sets a view on its block of
+     * the row-major values and they write them in one collective call.
+     * Called by all the SDDs.
+     *
+     * @param fileName path of the file
+     * @param quantity quantity of this SDD
+     * @param domain domain data
+     *
+     * @return 0 if writing succeeded
+     */
+    int writeSharedQuantity(const std::string& fileName,
+            const Quantity<real>& quantity,
+            const Domain& domain);
+
+    /*!
+     * @brief Copies the state and all the quantities of the SDD, both
+     * arrays, in a checkpoint (see CheckpointHeader).
+     *
+     * @param state state of the engine
+     * @param domain domain data
+     * @param buffer content of the checkpoint file, resized
+     */
+    void serializeCheckpoint(const CheckpointState& state, const Domain& domain,
+            std::vector<char>& buffer);
+
+    /*!
+     * @brief Writes a checkpoint: in fileName.tmp, synchronised on the disk
+     * and renamed, so that fileName is always a complete checkpoint.
+     *
+     * @return 0 if writing succeeded, 1 if the file can't be opened
+     */
+    int writeCheckpoint(const std::string& fileName, const std::vector<char>& buffer);
+
+    /*!
+     * @brief Reads the iteration of a checkpoint file.
+     *
+     * @return 0 if succeeded, -1 if there is no valid checkpoint
+     */
+    int readCheckpointIteration(const std::string& fileName, unsigned int& iteration);
+
+    /*!
+     * @brief Loads a checkpoint: the state of the engine, and the values
+     * and current arrays of the quantities of the SDD.
+     *
+     * @param fileName path of the file
+     * @param state state of the engine, resized
+     * @param domain domain data, built with the same quantities
+     */
+    int loadCheckpoint(const std::string& fileName, CheckpointState& state, Domain& domain);
+
     /*!
      *
      */
@@ -0,0 +1,59 @@
+#include "SnapshotWriter.hpp"
+#include "IO.hpp"
+#include "Domain.hpp"
+#include <iomanip>
+#include <sstream>
+
+SnapshotWriter::SnapshotWriter(const std::string& directory, const Domain& domain,
+        const std::vector<std::string>& quantityNames, bool append):
+    _quantityNames(quantityNames) {
+
+    const SDDistributed& sdd = domain.getSDDconst();
+    std::ostringstream oss;
+    oss << directory << "/sdd" << sdd.getId();
+    _sddPath = oss.str();
+
+    _sizeX = sdd.getSizeX();
+    _sizeY = sdd.getSizeY();
+    for (auto const& name: _quantityNames)
+        _quantities.push_back(sdd.getQuantity(name));
+
+    for (unsigned int b = 0; b < 2; ++b)
+        _buffers[b].values.assign(_quantities.size(), std::vector<real>(size_t(_sizeX) * _sizeY));
+
+    _list.open(_sddPath + "/snapshots.dat", append ? std::ios::app : std::ios::out);
+    _list << std::setprecision(Number::max_digits10);
+
+    start();
+}
+
+SnapshotWriter::~SnapshotWriter() {
+
+    stop();
+    _list.close();
+}
+
+void SnapshotWriter::push(unsigned int id, unsigned int iteration, real t) {
+
+    Snapshot& snapshot(acquire());
+    snapshot.id = id;
+    snapshot.iteration = iteration;
+    snapshot.t = t;
+    for (size_t q = 0; q < _quantities.size(); ++q) {
+        real* values(snapshot.values[q].data());
+        for (unsigned int j = 0; j < _sizeY; ++j)
+            _quantities[q]->getRange(values + size_t(j) * _sizeX, _sizeX, 0, j);
+    }
+
+    release();
+}
+
+void SnapshotWriter::writeBuffer(const Snapshot& snapshot) {
+
+    for (size_t q = 0; q < _quantities.size(); ++q) {
+        std::ostringstream oss;
+        oss << _sddPath << "/" << _quantityNames[q] << "-" << snapshot.id << ".bin";
+        IO::writeBinaryQuantity(oss.str(), snapshot.values[q].data(), _sizeX, _sizeY);
+    }
+    _list << snapshot.id << " " << snapshot.iteration << " " << snapshot.t << std::endl;
+}
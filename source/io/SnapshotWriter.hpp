@@ -0,0 +1,81 @@
+#ifndef SNAPSHOTWRITER_HPP
+#define SNAPSHOTWRITER_HPP
+
+/*!
+ * @file:
+ *
+ * @brief Periodic snapshots of the quantities, written by a background thread
+ */
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "number/number.hpp"
+#include "Quantity.hpp"
+#include "BufferedWriter.hpp"
+
+class Domain;
+
+/*!
+ * @brief Values of the quantities at one iteration, row by row
+ */
+struct Snapshot {
+    unsigned int id;
+    unsigned int iteration;
+    real t;
+    std::vector< std::vector<real> > values;
+};
+
+/*!
+ * @brief Writes snapshots of the quantities of a SDD during the iterations.
+ *
+ * The quantities are copied by push in a buffer written by the thread of
+ * BufferedWriter while the next iterations are computed: snapshot
+ * k of quantity q is directory/sddN/q-k.bin (see IO::writeBinaryQuantity),
+ * its iteration and time are appended to directory/sddN/snapshots.dat (a
+ * restart writes again the snapshots after its checkpoint).
+ */
+class SnapshotWriter: public BufferedWriter<Snapshot> {
+
+  public:
+
+    /*!
+     * @brief Constructor, starts the thread
+     *
+     * @param directory output folder
+     * @param domain domain, whose SDD quantities are copied
+     * @param quantityNames names of the quantities to write
+     * @param append true to append to snapshots.dat, when restarted
+     */
+    SnapshotWriter(const std::string& directory, const Domain& domain,
+            const std::vector<std::string>& quantityNames, bool append);
+
+    /*!
+     * @brief Destructor, waits for the snapshots left to be written
+     */
+    ~SnapshotWriter();
+
+    /*!
+     * @brief Copies the current values of the quantities and hands them to
+     * the thread.
+     *
+     * @param id number of the snapshot
+     * @param iteration number of the iteration
+     * @param t simulated time
+     */
+    void push(unsigned int id, unsigned int iteration, real t);
+
+  private:
+
+    void writeBuffer(const Snapshot& snapshot) override;
+
+    std::string _sddPath;
+    std::vector<std::string> _quantityNames;
+    std::vector<const Quantity<real>*> _quantities;
+    unsigned int _sizeX;
+    unsigned int _sizeY;
+
+    std::ofstream _list;
+};
+
+#endif
@@ -49,7 +49,9 @@ int BHydro::init() {
     IO::loadSDDInfo(_initpath, *_domain);
 
     // Now that the subdomains info were loaded they can be built
-    _domain->buildSubDomainsMPI(4, 1);
+    _timerSetup.begin();
+    _domain->buildSubDomainsMPI(4, 1, 3);
+    _timerSetup.end();
 
     // build SDS in each SDD.
     _domain->buildThreads();
@@ -70,7 +72,9 @@ int BHydro::init() {
     IO::loadBoundaryConditions(_initpath, *_domain);
 
     // Build communication maps between sdds (overlap and boundary).
+    _timerSetup.begin();
     _domain->buildCommunicationMap();
+    _timerSetup.end();
 
     unsigned int nSDS = _domain->getNumberSDS();
     _SDS_uxmax.resize(nSDS);
@@ -108,6 +112,7 @@ int BHydro::init() {
     #endif
 
     initial_condition();
+    initSnapshots(*_domain, {"rho", "rhou_x", "rhou_y"});
     return 0;
 }
 
@@ -251,6 +256,12 @@ int BHydro::start() {
 
    	    _timerComputation.end();
         // ----------------------------------------------------------------------
+        // The quantities are only computed from the bits for the snapshots,
+        // at the time of the end of the iteration.
+        _t = _dt * _nIterations;
+        if (snapshotDue())
+            convolution();
+        snapshot();
         _timerIteration.end();
     }
     printStatus(true);
@@ -24,7 +24,7 @@ int EulerRuO1::init() {
     // Init domain
     _domain = new Domain();
 
-    IO::loadDomainInfo(_initpath, *_domain);
+    const unsigned int BClayer = IO::loadDomainInfo(_initpath, *_domain);
 
     _Nx = _domain->getSizeX();
     _Ny = _domain->getSizeY();
@@ -37,8 +37,48 @@ int EulerRuO1::init() {
     IO::loadExecOptions(_initpath, *_domain);
     IO::loadSDDInfo(_initpath, *_domain);
 
+    // Deep halo: haloDepth layers of overlap cells, corners included, are
+    // exchanged once every haloDepth iterations.
+    _haloDepth = std::stoul(_domain->getExecOption("haloDepth", "1"));
+    if (_haloDepth < 1 || _haloDepth > BClayer)
+        exitfail("The halo depth must be between 1 and the number of boundary layers of the case: " + std::to_string(BClayer));
+
     // Now that the subdomains info were loaded they can be built
-    _domain->buildSubDomainsMPI(4, 1);
+    _timerSetup.begin();
+    _domain->buildSubDomainsMPI(_haloDepth > 1 ? 8 : 4, _haloDepth, 7);
+    _timerSetup.end();
+
+    // "fused": the speed of the next iteration is computed by the flux.
+    const std::string sweep(_domain->getExecOption("sweep", "split"));
+    if (sweep != "split" && sweep != "fused")
+        exitfail("Unknown sweep: " + sweep);
+    _fusedSweep = (sweep == "fused");
+
+    // "overlap": the flux of the SDSs far from the overlap cells is computed
+    // during the communications.
+    const std::string halo(_domain->getExecOption("halo", "blocking"));
+    if (halo != "blocking" && halo != "overlap")
+        exitfail("Unknown halo: " + halo);
+    _haloOverlap = (halo == "overlap");
+
+    // "agreed": the SDDs agree on dt and t with extra collectives, for
+    // rounding modes that are not deterministic (random rounding of verrou).
+    // "pipelined": the reduction of the maxima is non-blocking, the flux
+    // differences are computed while it completes.
+    const std::string dtReduction(_domain->getExecOption("dtReduction", "single"));
+    if (dtReduction != "single" && dtReduction != "agreed" && dtReduction != "pipelined")
+        exitfail("Unknown dt reduction: " + dtReduction);
+    _agreedTimeStep = (dtReduction == "agreed");
+    _pipelinedTimeStep = (dtReduction == "pipelined");
+
+    // The ghost layers are computed by the speed and the flux in sequence.
+    if (_haloDepth > 1 && (_fusedSweep || _haloOverlap || _pipelinedTimeStep))
+        exitfail("haloDepth > 1 requires sweep=split, halo=blocking and dtReduction=single or agreed.");
+
+    #ifdef EULERRUO1_SIMD
+    // The vectorised kernels read the neighbours of a range as ranges.
+    _rowMajor = (_domain->getExecOption("cellOrder", CoordConverter::ROW_MAJOR) == CoordConverter::ROW_MAJOR);
+    #endif
 
     // build SDS in each SDD.
     _domain->buildThreads();
@@ -47,8 +87,9 @@ int EulerRuO1::init() {
     if (_MPI_rank == 0)
         _domain->showInfo();
 
-    // Initial time and error.
+    // Initial time, error and iteration.
     _t = 0.; _t_err = 0.;
+    _nIterations = 0;
 
     // Initial last.
     _last_dt = -1.0;
@@ -56,20 +97,25 @@ int EulerRuO1::init() {
     // Initial min.
     _min_dt = std::numeric_limits<real>::max();
 
+    // The conserved quantities are read and written together by the flux.
+    _domain->addQuantityGroup({"rho", "rhou_x", "rhou_y", "rhoE"});
+
     // Loading initial values
-    IO::loadQuantity(_initpath, "rho", *_domain);
-    IO::loadQuantity(_initpath, "rhou_x", *_domain);
-    IO::loadQuantity(_initpath, "rhou_y", *_domain);
-    IO::loadQuantity(_initpath, "rhoE", *_domain);
-    IO::loadQuantity(_initpath, "pressure", *_domain);
-    IO::loadQuantity(_initpath, "sx", *_domain);
-    IO::loadQuantity(_initpath, "sy", *_domain);
+    loadQuantity(*_domain, "rho");
+    loadQuantity(*_domain, "rhou_x");
+    loadQuantity(*_domain, "rhou_y");
+    loadQuantity(*_domain, "rhoE");
+    loadQuantity(*_domain, "pressure");
+    loadQuantity(*_domain, "sx");
+    loadQuantity(*_domain, "sy");
 
     // Loading boundary conditions on \rho and \rhoE
     IO::loadBoundaryConditions(_initpath, *_domain);
 
     // Build communication maps between sdds (overlap and boundary).
+    _timerSetup.begin();
     _domain->buildCommunicationMap();
+    _timerSetup.end();
 
     unsigned int nSDS = _domain->getNumberSDS();
     _SDS_uxmax.resize(nSDS);
@@ -77,6 +123,13 @@ int EulerRuO1::init() {
     std::fill(_SDS_uxmax.begin(), _SDS_uxmax.end(), 0);
     std::fill(_SDS_uymax.begin(), _SDS_uymax.end(), 0);
 
+    if (_haloDepth > 1)
+        _domain->buildHaloSDS(_haloDepth - 1);
+
+    // Sized by the first fluxDifference of each SDS, on its thread.
+    if (_pipelinedTimeStep)
+        _fluxDifference.resize(nSDS);
+
     // Init tasks pool
     _domain->addEquation("speed", std::bind(&EulerRuO1::speed, this,
                                    std::placeholders::_1, std::placeholders::_2));
@@ -84,12 +137,51 @@ int EulerRuO1::init() {
     _domain->addEquation("flux", std::bind(&EulerRuO1::flux, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
+    if (_haloDepth > 1) {
+        _domain->addHaloEquation("speed", std::bind(&EulerRuO1::speed, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+        _domain->addHaloEquation("flux", std::bind(&EulerRuO1::flux, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+    }
+
+    if (_haloOverlap) {
+        _domain->addSplitEquation("flux", std::bind(&EulerRuO1::flux, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+        if (_fusedSweep)
+            _domain->addSplitEquation("fluxSpeed", std::bind(&EulerRuO1::fluxSpeed, this,
+                                           std::placeholders::_1, std::placeholders::_2));
+    }
+
     _domain->addEquation("updateBoundary", std::bind(&EulerRuO1::updateBoundary, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
     _domain->addEquation("updatePressure", std::bind(&EulerRuO1::updatePressure, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
+    if (_pipelinedTimeStep) {
+        _domain->addEquation("fluxDifference", std::bind(&EulerRuO1::fluxDifference, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+        if (_haloOverlap)
+            _domain->addSplitEquation("fluxDifference", std::bind(&EulerRuO1::fluxDifference, this,
+                                           std::placeholders::_1, std::placeholders::_2));
+
+        _domain->addEquation("fluxUpdate", std::bind(&EulerRuO1::fluxUpdate, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+        if (_fusedSweep)
+            _domain->addEquation("fluxUpdateSpeed", std::bind(&EulerRuO1::fluxUpdateSpeed, this,
+                                           std::placeholders::_1, std::placeholders::_2));
+    }
+
+    if (_fusedSweep)
+        _domain->addEquation("fluxSpeed", std::bind(&EulerRuO1::fluxSpeed, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+
+    if (_fusedSweep || _haloDepth > 1)
+        _domain->addEquation("updateBoundaries", std::bind(&EulerRuO1::updateBoundaries, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+
+    initSnapshots(*_domain, {"rho", "rhou_x", "rhou_y", "rhoE"});
+    initCheckpoints(*_domain, {&_dt, &_t_err, &_last_dt, &_min_dt});
     return 0;
 }
 
@@ -102,7 +194,7 @@ int EulerRuO1::start() {
     MPI_Barrier(MPI_COMM_WORLD);
     #endif
 
-    _nIterations = 0;
+    bool speedDone(false);
     while (_t < _T) {
         printStatus();
 
@@ -112,41 +204,131 @@ int EulerRuO1::start() {
 
         ++_nIterations;
 
-        // Compute pressure and speed.
-        _domain->execEquation("updateBoundary");
-
-        // ----------------------------------------------------------------------
-        // (with a stencil of one, it's not required here because there is no overlap/boundary cell needed in the computation).
-   	    /* _timerComputation.end();
-        _domain->updateOverlapCells();
-        _timerComputation.begin(); */
-        // ----------------------------------------------------------------------
-
-        // Compute interface speed and pressure in cell.
-        _domain->execEquation("speed");
-
-        // Copy the pressure value in boundary.
-        _domain->execEquation("updatePressure");
-
-        // ----------------------------------------------------------------------
-        // Communicate the fluxes computed.
-   	    _timerComputation.end();
-        _domain->updateOverlapCells();
-        computeDT();
-        _timerComputation.begin();
-        // ----------------------------------------------------------------------
+        // Deep halo: the overlap cells are exchanged at the first step of a
+        // block of _haloDepth steps. At the step m of the block, the ghost
+        // layers 1 to _haloDepth - m are still valid: the speed is computed
+        // on them and the flux on the layers 1 to _haloDepth - m - 1.
+        const unsigned int blockStep((_nIterations - 1) % _haloDepth);
+
+        if (speedDone) {
+            // Pressure and speed were computed by the last sweep.
+            _domain->execEquation("updateBoundaries");
+        } else {
+            // Compute pressure and speed.
+            _domain->execEquation("updateBoundary");
+
+            // ----------------------------------------------------------------------
+            // (with a stencil of one, it's not required here because there is no overlap/boundary cell needed in the computation).
+            /* _timerComputation.end();
+            _domain->updateOverlapCells();
+            _timerComputation.begin(); */
+            // ----------------------------------------------------------------------
+
+            // Compute interface speed and pressure in cell.
+            _domain->execEquation("speed");
+            if (blockStep > 0)
+                _domain->execHaloEquation("speed", _haloDepth - blockStep);
+
+            // Copy the pressure value in boundary.
+            _domain->execEquation("updatePressure");
+        }
 
-        // Start works on this equation
-        _domain->execEquation("flux");
+        if (_pipelinedTimeStep) {
+            // The maxima are reduced while the flux differences, which don't
+            // depend on dt, are computed.
+            if (_haloOverlap) {
+                _domain->startOverlapCells();
+                startDomainUmax();
+                _domain->execInteriorEquation("fluxDifference");
+
+                // ----------------------------------------------------------------------
+                _timerComputation.end();
+                _domain->finishOverlapCells();
+                _timerComputation.begin();
+                // ----------------------------------------------------------------------
+
+                _domain->execBorderEquation("fluxDifference");
+            } else {
+                // ----------------------------------------------------------------------
+                _timerComputation.end();
+                _domain->updateOverlapCells();
+                startDomainUmax();
+                _timerComputation.begin();
+                // ----------------------------------------------------------------------
+
+                _domain->execEquation("fluxDifference");
+            }
+
+            // ----------------------------------------------------------------------
+            _timerComputation.end();
+            finishDomainUmax();
+            updateTimeStep();
+            _timerComputation.begin();
+            // ----------------------------------------------------------------------
+
+            speedDone = _fusedSweep && _t < _T;
+            _domain->execEquation(speedDone ? "fluxUpdateSpeed" : "fluxUpdate");
+        } else if (_haloOverlap) {
+            // Post the communications, the interior SDSs don't read the
+            // overlap cells and are computed while they are in flight.
+            _domain->startOverlapCells();
+            computeDT();
+
+            speedDone = _fusedSweep && _t < _T;
+            const std::string fluxEquation(speedDone ? "fluxSpeed" : "flux");
+            _domain->execInteriorEquation(fluxEquation);
+
+            // ----------------------------------------------------------------------
+            _timerComputation.end();
+            _domain->finishOverlapCells();
+            _timerComputation.begin();
+            // ----------------------------------------------------------------------
+
+            _domain->execBorderEquation(fluxEquation);
+        } else {
+            // ----------------------------------------------------------------------
+            // Communicate the fluxes computed.
+            _timerComputation.end();
+            if (blockStep == 0)
+                _domain->updateOverlapCells();
+            _timerComputation.begin();
+
+            // Deep halo: the boundary cells mirroring ghost cells are updated
+            // again now that these are received (before t moves).
+            if (blockStep == 0 && _haloDepth > 1)
+                _domain->execEquation("updateBoundaries");
+
+            _timerComputation.end();
+            computeDT();
+            _timerComputation.begin();
+            // ----------------------------------------------------------------------
+
+            // Start works on this equation, the fused sweep also computes the
+            // pressure and speed of the new values (but for the last iteration).
+            speedDone = _fusedSweep && _t < _T;
+            if (speedDone)
+                _domain->execEquation("fluxSpeed");
+            else
+                _domain->execEquation("flux");
+            _domain->execHaloEquation("flux", _haloDepth - 1 - blockStep);
+        }
 
         _domain->switchQuantityPrevNext("rho");
         _domain->switchQuantityPrevNext("rhou_x");
         _domain->switchQuantityPrevNext("rhou_y");
         _domain->switchQuantityPrevNext("rhoE");
 
+        if (speedDone) {
+            _domain->switchQuantityPrevNext("pressure");
+            _domain->switchQuantityPrevNext("sx");
+            _domain->switchQuantityPrevNext("sy");
+        }
+
    	    _timerComputation.end();
         // ----------------------------------------------------------------------
+        snapshot();
         _timerIteration.end();
+        checkpoint();
     }
 
     printStatus(true);
@@ -156,22 +338,23 @@ int EulerRuO1::start() {
 // Updating according to CFL and max velocity
 void EulerRuO1::computeDT() {
 
-    if (_Ny == 1) {
-        _SDD_uxmax = *std::max_element(_SDS_uxmax.begin(), _SDS_uxmax.end());
-        _dt = _CFL * _dx / _SDD_uxmax;
-    }
+    // The only collective of the step: the maxima are exact, so every SDD
+    // computes the same dt and t from them.
+    updateDomainUmax();
+    updateTimeStep();
+}
 
-    if (_Nx == 1) {
-        _SDD_uymax = *std::max_element(_SDS_uymax.begin(), _SDS_uymax.end());
-        _dt = _CFL * _dy / _SDD_uymax;
-    }
+void EulerRuO1::updateTimeStep() {
+
+    if (_Ny == 1)
+        _dt = _CFL * _dx / _Domain_uxmax;
+
+    if (_Nx == 1)
+        _dt = _CFL * _dy / _Domain_uymax;
 
     // Real formula in two dimensions
-    if (_Nx > 1 && _Ny > 1) {
-        // We need the max above all to be reproducible.
-        updateDomainUmax();
+    if (_Nx > 1 && _Ny > 1)
         _dt = _CFL * _dx * _dy / (_Domain_uxmax * _dy + _Domain_uymax * _dx);
-    }
 
     // Max increase.
     /*
@@ -184,7 +367,8 @@ void EulerRuO1::computeDT() {
 
     // If the computation is set with random rounding error, the dt may differ among the sub-domains.
     // To ensure the computation (and also the number of iteration), we must communicate it.
-    _dt = reduceMin(_dt);
+    if (_agreedTimeStep)
+        _dt = reduceMin(_dt);
 
     #ifndef NDEBUG
     // Show if dt drops.
@@ -205,13 +389,14 @@ void EulerRuO1::computeDT() {
     #endif
 
     // add timestep to global time.
-    if (_MPI_rank == 0) {
+    if (!_agreedTimeStep || _MPI_rank == 0) {
         real y = _dt + _t_err;
         Number::fastTwoSum(_t, y, _t, _t_err);
     }
 
     #ifndef SEQUENTIAL
-    MPI_Bcast(&_t, 1, MPI_REALTYPE, 0, MPI_COMM_WORLD);
+    if (_agreedTimeStep)
+        MPI_Bcast(&_t, 1, MPI_REALTYPE, 0, MPI_COMM_WORLD);
     #endif
 
     // Store current dt
@@ -261,13 +446,116 @@ real EulerRuO1::computeSoundSpeed(const real& rho, const real& P) {
 }
 
 void EulerRuO1::speed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
-    Quantity<real>& rho = *quantityMap.at("rho");
-    Quantity<real>& rhou_x = *quantityMap.at("rhou_x");
-    Quantity<real>& rhou_y = *quantityMap.at("rhou_y");
-    Quantity<real>& rhoE = *quantityMap.at("rhoE");
-    Quantity<real>& pressure = *quantityMap.at("pressure");
-    Quantity<real>& sx = *quantityMap.at("sx");
-    Quantity<real>& sy = *quantityMap.at("sy");
+    // The layout of the conserved quantities is the same for the group.
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    #ifdef EULERRUO1_SIMD
+    if (lanes == 1 && _rowMajor) {
+        speedSimd(sds, quantityMap);
+        return;
+    }
+    #endif
+    if (lanes == 1)
+        speedKernel<1>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        speedKernel<Quantity<real>::aosoaLanes>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::speed.");
+}
+
+void EulerRuO1::flux(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    #ifdef EULERRUO1_SIMD
+    if (lanes == 1 && _rowMajor) {
+        fluxSimd<false>(sds, quantityMap);
+        return;
+    }
+    #endif
+    if (lanes == 1)
+        fluxKernel<1, false>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxKernel<Quantity<real>::aosoaLanes, false>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::flux.");
+}
+
+void EulerRuO1::fluxSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    #ifdef EULERRUO1_SIMD
+    if (lanes == 1 && _rowMajor) {
+        fluxSimd<true>(sds, quantityMap);
+        return;
+    }
+    #endif
+    if (lanes == 1)
+        fluxKernel<1, true>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxKernel<Quantity<real>::aosoaLanes, true>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::fluxSpeed.");
+}
+
+void EulerRuO1::fluxDifference(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        fluxDifferenceKernel<1>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxDifferenceKernel<Quantity<real>::aosoaLanes>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::fluxDifference.");
+}
+
+void EulerRuO1::fluxUpdate(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        fluxUpdateKernel<1, false>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxUpdateKernel<Quantity<real>::aosoaLanes, false>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::fluxUpdate.");
+}
+
+void EulerRuO1::fluxUpdateSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        fluxUpdateKernel<1, true>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxUpdateKernel<Quantity<real>::aosoaLanes, true>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO1::fluxUpdateSpeed.");
+}
+
+inline void EulerRuO1::cellSpeed(const real rho_center, const real rhou_x_center, const real rhou_y_center, const real rhoE_center,
+        real& pressure_center, real& sx_center, real& sy_center) {
+
+    if (rho_center == Number::zero) {
+        pressure_center = Number::zero;
+        sx_center = Number::zero;
+        sy_center = Number::zero;
+        return;
+    }
+
+    // This should never be negative of course.
+    assert(rho_center > 0.);
+
+    const real ux = rhou_x_center / rho_center;
+    const real uy = rhou_y_center / rho_center;
+    const real Ek = Number::half * (ux * rhou_x_center + uy * rhou_y_center);
+    pressure_center = computePressure(Ek, rhoE_center);
+    const real c = computeSoundSpeed(rho_center, pressure_center);
+
+    sx_center = std::max(rabs(ux + c), rabs(ux - c));
+    sy_center = std::max(rabs(uy + c), rabs(uy - c));
+}
+
+template<unsigned int Lanes>
+void EulerRuO1::speedKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, 1> pressure = quantityMap.at("pressure")->view0<1>();
+    const QuantityView<real, 1> sx = quantityMap.at("sx")->view0<1>();
+    const QuantityView<real, 1> sy = quantityMap.at("sy")->view0<1>();
 
     // P = gamma * (gamma - 1.) * rho * e
     // c = sqrt(gamma * P / rho);
@@ -277,60 +565,121 @@ void EulerRuO1::speed(const SDShared& sds, const std::map< std::string, Quantity
     // s_y = a^n_{i, j+1/2} = max(max(|u_y^n_{i,j} + c^n_{i,j}|, |u_y^n_{i,j} - c^n_{i,j}|), max(|u_y^n_{i,j+1} + c^n_{i,j+1}|, |u_y^n_{i,j+1} - c^n_{i,j+1}|))
 
     real sdsUxMax(Number::zero), sdsUyMax(Number::zero);
-    for (const auto& coords: sds) {
-        const int i = coords.first;
-        const int j = coords.second;
-        size_t k_center = sds.convert(i, j);
-
-        const real rho_center = rho.get0(k_center);
-        if (rho_center == Number::zero) {
-            pressure.set0(Number::zero, k_center);
-            sx.set0(Number::zero, k_center);
-            sy.set0(Number::zero, k_center);
-            continue;
+    for (const auto& range: sds.getRanges()) {
+        size_t k_center = sds.convert(range.x, range.y);
+        for (unsigned int i = 0; i < range.length; ++i, ++k_center) {
+            real sx_center, sy_center;
+            cellSpeed(rho[k_center], rhou_x[k_center], rhou_y[k_center], rhoE[k_center],
+                    pressure[k_center], sx_center, sy_center);
+            sx[k_center] = sx_center;
+            sy[k_center] = sy_center;
+
+            if (sdsUxMax < sx_center)
+                sdsUxMax = sx_center;
+
+            if (sdsUyMax < sy_center)
+                sdsUyMax = sy_center;
         }
+    }
 
-        // This should never be negative of course.
-        assert(rho_center > 0.);
+    // Updating umax and uymax, the ghost layers of the deep halo are
+    // accounted by the SDDs owning them.
+    if (sds.getId() < _SDS_uxmax.size()) {
+        _SDS_uxmax[sds.getId()] = sdsUxMax;
+        _SDS_uymax[sds.getId()] = sdsUyMax;
+    }
+}
 
-        const real rhou_x_center = rhou_x.get0(k_center);
-        const real rhou_y_center = rhou_y.get0(k_center);
-        const real rhoE_center = rhoE.get0(k_center);
+template<unsigned int Lanes>
+inline void EulerRuO1::cellFluxDifferences(const QuantityView<real, Lanes>& rho, const QuantityView<real, Lanes>& rhou_x,
+        const QuantityView<real, Lanes>& rhou_y, const QuantityView<real, Lanes>& rhoE,
+        const QuantityView<real, 1>& pressure, const QuantityView<real, 1>& sx, const QuantityView<real, 1>& sy,
+        size_t k_center, size_t k_left, size_t k_right, size_t k_bottom, size_t k_top, real* __restrict flux) {
 
-        const real ux = rhou_x_center / rho_center;
-        const real uy = rhou_y_center / rho_center;
-        const real Ek = Number::half * (ux * rhou_x_center + uy * rhou_y_center);
-        const real pressure_center = computePressure(Ek, rhoE_center);
-        pressure.set0(pressure_center, k_center);
-        const real c = computeSoundSpeed(rho_center, pressure_center);
+    real rho_left = rho[k_left];
+    real rho_center = rho[k_center];
+    real rho_right = rho[k_right];
+    real rho_top = rho[k_top];
+    real rho_bottom = rho[k_bottom];
 
-        const real sx_center = std::max(rabs(ux + c), rabs(ux - c));
-        sx.set0(sx_center, k_center);
+    real rhou_x_left = rhou_x[k_left];
+    real rhou_x_center = rhou_x[k_center];
+    real rhou_x_right = rhou_x[k_right];
+    real rhou_x_top = rhou_x[k_top];
+    real rhou_x_bottom = rhou_x[k_bottom];
 
-        const real sy_center = std::max(rabs(uy + c), rabs(uy - c));
-        sy.set0(sy_center, k_center);
+    real rhou_y_left = rhou_y[k_left];
+    real rhou_y_center = rhou_y[k_center];
+    real rhou_y_right = rhou_y[k_right];
+    real rhou_y_top = rhou_y[k_top];
+    real rhou_y_bottom = rhou_y[k_bottom];
 
-        if (sdsUxMax < sx_center)
-            sdsUxMax = sx_center;
+    real rhoE_left = rhoE[k_left];
+    real rhoE_center = rhoE[k_center];
+    real rhoE_right = rhoE[k_right];
+    real rhoE_top = rhoE[k_top];
+    real rhoE_bottom = rhoE[k_bottom];
 
-        if (sdsUyMax < sy_center)
-            sdsUyMax = sy_center;
-    }
+    real cell_sx_center = sx[k_center];
+    real cell_sy_center = sy[k_center];
 
-    // Updating umax and uymax
-    _SDS_uxmax[sds.getId()] = sdsUxMax;
-    _SDS_uymax[sds.getId()] = sdsUyMax;
-}
+    real sx_left  = std::max(sx[k_left], cell_sx_center);
+    real sx_right = std::max(sx[k_right], cell_sx_center);
 
-void EulerRuO1::flux(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    real sy_top  = std::max(sy[k_top], cell_sy_center);
+    real sy_bottom = std::max(sy[k_bottom], cell_sy_center);
+
+    real ux_left = (rho_left == Number::zero) ? Number::zero : rhou_x_left / rho_left;
+    real ux_right = (rho_right == Number::zero) ? Number::zero : rhou_x_right / rho_right;
+
+    real uy_top = (rho_top == Number::zero) ? Number::zero : rhou_y_top / rho_top;
+    real uy_bottom = (rho_bottom == Number::zero) ? Number::zero : rhou_y_bottom / rho_bottom;
+
+    real pressure_left = pressure[k_left];
+    real pressure_right = pressure[k_right];
+    real pressure_top = pressure[k_top];
+    real pressure_bottom = pressure[k_bottom];
+
+    // U = (rho, rhou_x, rhou_y, rhoE)
+    // F = (rhou_x, rhou_x * rhou_x / rho + P, rhou_x *rhou_y / rho, (rhoE + P) * rhou_x / rho)
+    // F^n_x = (1. / 2.) * ( F(U^n_{i + 1,j}) - F(U^n_{i - 1,j}) - a^n_{i+1/2,j} * (U^n_{i+1, j} - U^n_{i, j}) + a^n_{i-1/2,j} * (U^n_{i, j} - U^n_{i-1, j}))
+
+    // G = (rhou_y, rhou_x *rhou_y / rho, rhou_y * rhou_y / rho + P, (rhoE + P) * rhou_y / rho)
+    // G^n_y = (1. / 2.) * ( G(U^n_{i,j + 1}) - G(U^n_{i,j - 1}) - a^n_{i,j+1/2} * (U^n_{i, j+1} - U^n_{i, j}) + a^n_{i,j-1/2} * (U^n_{i, j} - U^n_{i, j-1}))
 
-    Quantity<real>& rho = *quantityMap.at("rho");
-    Quantity<real>& rhou_x = *quantityMap.at("rhou_x");
-    Quantity<real>& rhou_y = *quantityMap.at("rhou_y");
-    Quantity<real>& rhoE = *quantityMap.at("rhoE");
-    Quantity<real>& pressure = *quantityMap.at("pressure");
-    Quantity<real>& sx = *quantityMap.at("sx");
-    Quantity<real>& sy = *quantityMap.at("sy");
+    // Horizontal Flux
+    flux[0] = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
+    flux[2] = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
+    flux[4] = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
+    flux[6] = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
+
+    // Vertical flux
+    flux[1] = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
+    flux[3] = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
+    flux[5] = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
+    flux[7] = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
+}
+
+template<unsigned int Lanes, bool Fused>
+void EulerRuO1::fluxKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rho_next = quantityMap.at("rho")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x_next = quantityMap.at("rhou_x")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y_next = quantityMap.at("rhou_y")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE_next = quantityMap.at("rhoE")->view1<Lanes>();
+    const QuantityView<real, 1> pressure = quantityMap.at("pressure")->view0<1>();
+    const QuantityView<real, 1> sx = quantityMap.at("sx")->view0<1>();
+    const QuantityView<real, 1> sy = quantityMap.at("sy")->view0<1>();
+
+    // Fused sweep: pressure and speed of the new values (see fluxSpeed).
+    const QuantityView<real, 1> pressure_next = quantityMap.at("pressure")->view1<1>();
+    const QuantityView<real, 1> sx_next = quantityMap.at("sx")->view1<1>();
+    const QuantityView<real, 1> sy_next = quantityMap.at("sy")->view1<1>();
+    real sdsUxMax(Number::zero), sdsUyMax(Number::zero);
 
     // U^{n+1}_{i,j} = U^n_{i,j} - dt / dx * (F^n_{i+1/2, j} - F^n_{i-1/2, j}) - dt / dy * (G^n_{i, j+1/2} - G^n_{i, j-1/2})
     // U^{n+1}_{i,j} = U^n_{i,j} - dt / dx * (F^n_x) - dt / dy * (G^n_y)
@@ -360,154 +709,154 @@ void EulerRuO1::flux(const SDShared& sds, const std::map< std::string, Quantity<
     const real kx = Number::half * _dt / _dx;
     const real ky = Number::half * _dt / _dy;
 
-    for (const auto& coords: sds) {
-
-        const int i = coords.first;
-        const int j = coords.second;
-        size_t k_bottom = sds.convert(i, j - 1);
-        size_t k_top = sds.convert(i, j + 1);
-        size_t k_center = sds.convert(i, j);
-        size_t k_left(k_center - 1);
-        size_t k_right(k_center + 1);
-
-        real rho_left = rho.get0(k_left);
-        real rho_center = rho.get0(k_center);
-        real rho_right = rho.get0(k_right);
-        real rho_top = rho.get0(k_top);
-        real rho_bottom = rho.get0(k_bottom);
-
-        real rhou_x_left = rhou_x.get0(k_left);
-        real rhou_x_center = rhou_x.get0(k_center);
-        real rhou_x_right = rhou_x.get0(k_right);
-        real rhou_x_top = rhou_x.get0(k_top);
-        real rhou_x_bottom = rhou_x.get0(k_bottom);
-
-        real rhou_y_left = rhou_y.get0(k_left);
-        real rhou_y_center = rhou_y.get0(k_center);
-        real rhou_y_right = rhou_y.get0(k_right);
-        real rhou_y_top = rhou_y.get0(k_top);
-        real rhou_y_bottom = rhou_y.get0(k_bottom);
-
-        /*
-        if (rhou_y_center != 0. || rhou_y_left != 0. || rhou_y_right != 0.) {
-            std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
-            std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
-            std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
-            exitfail(1);
-        } */
-
-        real rhoE_left = rhoE.get0(k_left);
-        real rhoE_center = rhoE.get0(k_center);
-        real rhoE_right = rhoE.get0(k_right);
-        real rhoE_top = rhoE.get0(k_top);
-        real rhoE_bottom = rhoE.get0(k_bottom);
-
-        real cell_sx_left = sx.get0(k_left);
-        real cell_sx_center = sx.get0(k_center);
-        real cell_sx_right = sx.get0(k_right);
-
-        real cell_sy_top = sy.get0(k_top);
-        real cell_sy_center = sy.get0(k_center);
-        real cell_sy_bottom = sy.get0(k_bottom);
-
-        real sx_left  = std::max(cell_sx_left, cell_sx_center);
-        real sx_right = std::max(cell_sx_right, cell_sx_center);
-
-        real sy_top  = std::max(cell_sy_top, cell_sy_center);
-        real sy_bottom = std::max(cell_sy_bottom, cell_sy_center);
-
-        real ux_left = (rho_left == Number::zero) ? Number::zero : rhou_x_left / rho_left;
-        real ux_right = (rho_right == Number::zero) ? Number::zero : rhou_x_right / rho_right;
-
-        real uy_top = (rho_top == Number::zero) ? Number::zero : rhou_y_top / rho_top;
-        real uy_bottom = (rho_bottom == Number::zero) ? Number::zero : rhou_y_bottom / rho_bottom;
-
-        real pressure_left = pressure.get0(k_left);
-        real pressure_right = pressure.get0(k_right);
-        real pressure_top = pressure.get0(k_top);
-        real pressure_bottom = pressure.get0(k_bottom);
-
-        // U = (rho, rhou_x, rhou_y, rhoE)
-        // F = (rhou_x, rhou_x * rhou_x / rho + P, rhou_x *rhou_y / rho, (rhoE + P) * rhou_x / rho)
-        // F^n_x = (1. / 2.) * ( F(U^n_{i + 1,j}) - F(U^n_{i - 1,j}) - a^n_{i+1/2,j} * (U^n_{i+1, j} - U^n_{i, j}) + a^n_{i-1/2,j} * (U^n_{i, j} - U^n_{i-1, j}))
-
-        // G = (rhou_y, rhou_x *rhou_y / rho, rhou_y * rhou_y / rho + P, (rhoE + P) * rhou_y / rho)
-        // G^n_y = (1. / 2.) * ( G(U^n_{i,j + 1}) - G(U^n_{i,j - 1}) - a^n_{i,j+1/2} * (U^n_{i, j+1} - U^n_{i, j}) + a^n_{i,j-1/2} * (U^n_{i, j} - U^n_{i, j-1}))
-
-        // Horizontal Flux
-        real rho_flux_x = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
-
-        real rhou_x_flux_x = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
-
-        real rhou_y_flux_x = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
-
-        real rhoE_flux_x = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
-
-        // Vertical flux
-        real rho_flux_y = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
-
-        real rhou_x_flux_y = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
-
-        real rhou_y_flux_y = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
-
-        real rhoE_flux_y = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
-
-        // Set new values.
-        rho.set1(rho_center - kx * rho_flux_x - ky * rho_flux_y, k_center);
-        rhou_x.set1(rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y, k_center);
-        rhou_y.set1(rhou_y_center - kx * rhou_y_flux_x - ky * rhou_y_flux_y, k_center);
-        rhoE.set1(rhoE_center - kx * rhoE_flux_x  - ky * rhoE_flux_y, k_center);
-
-
-        if (rho.get1(k_center) < Number::zero) {
-            std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
-            std::cout << "ux_right: " <<  ux_right << ", rhou_y_right: " <<  rhou_y_right << " = " << ux_right * rhou_y_right  << std::endl;
-            std::cout << "ux_left: " <<  ux_left << ", rhou_y_left: " <<  rhou_y_left << " = " << ux_left * rhou_y_left  << std::endl;
-            std::cout << "sx_right: " <<  sx_right << ", (rhou_y_right - rhou_y_center): " <<  (rhou_y_right - rhou_y_center) << " = " << sx_right * (rhou_y_right - rhou_y_center)  << std::endl;
-            std::cout << "sx_left: " <<  sx_left << ", (rhou_y_center - rhou_y_left): " <<  (rhou_y_center - rhou_y_left) << " = " << sx_left * (rhou_y_center - rhou_y_left)  << std::endl;
-
-            std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
-
-            std::cout << "rhou_y_flux_x: " <<  rhou_y_flux_x << std::endl << std::endl;
-
-            std::cout << "uy_top: " <<  uy_top<< ", rhou_y_top: " <<  rhou_y_top << " = " << uy_top * rhou_y_top  << std::endl;
-            std::cout << "uy_bottom: " <<  uy_bottom << ", rhou_y_bottom: " <<  rhou_y_bottom << " = " << uy_bottom * rhou_y_bottom  << std::endl;
-            std::cout << "sy_top: " <<  sy_top << ", (rhou_y_top - rhou_y_center): " <<  (rhou_y_top - rhou_y_center) << " = " << sy_top * (rhou_y_top - rhou_y_center)  << std::endl;
-            std::cout << "sy_bottom: " <<  sy_bottom << ", (rhou_y_center - rhou_y_bottom): " <<  (rhou_y_center - rhou_y_bottom) << " = " << sy_bottom * (rhou_y_center - rhou_y_bottom) << std::endl;
-            std::cout << "pressure_top: " <<  pressure_top << std::endl;
-            std::cout << "pressure_bottom: " <<  pressure_bottom << std::endl;
-            std::cout << "rhou_y_top: " <<  rhou_y_top << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_bottom: " <<  rhou_y_bottom << std::endl;
-            std::cout << "rhou_y_flux_y: " <<  rhou_y_flux_y << std::endl;
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        size_t k_center = sds.convert(range.x, j);
+        for (int i = range.x; i < range.x + int(range.length); ++i, ++k_center) {
+            size_t k_bottom = sds.convert(i, j - 1);
+            size_t k_top = sds.convert(i, j + 1);
+            size_t k_left = sds.convert(i - 1, j);
+            size_t k_right = sds.convert(i + 1, j);
+
+            real flux[nFluxDifferences];
+            cellFluxDifferences(rho, rhou_x, rhou_y, rhoE, pressure, sx, sy,
+                    k_center, k_left, k_right, k_bottom, k_top, flux);
+
+            // Set new values.
+            rho_next[k_center] = rho[k_center] - kx * flux[0] - ky * flux[1];
+            rhou_x_next[k_center] = rhou_x[k_center] - kx * flux[2] - ky * flux[3];
+            rhou_y_next[k_center] = rhou_y[k_center] - kx * flux[4] - ky * flux[5];
+            rhoE_next[k_center] = rhoE[k_center] - kx * flux[6]  - ky * flux[7];
+
+            if (rho_next[k_center] < Number::zero) {
+                std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
+                std::cout << "rho_center: " <<  rho[k_center] << std::endl;
+                std::cout << "kx * rho_flux_x: " <<  kx * flux[0] << std::endl;
+                std::cout << "ky * rho_flux_y: " <<  ky * flux[1] << std::endl;
+                std::cout << "rho.get1(k_center): " <<  rho_next[k_center] << std::endl;
+                std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
+                std::cout << sds.getNumberBoundaryCells() << std::endl;
+                exitfail(1);
+            }
+
+            if (Fused) {
+                real sx_center, sy_center;
+                cellSpeed(rho_next[k_center], rhou_x_next[k_center], rhou_y_next[k_center], rhoE_next[k_center],
+                        pressure_next[k_center], sx_center, sy_center);
+                sx_next[k_center] = sx_center;
+                sy_next[k_center] = sy_center;
+
+                if (sdsUxMax < sx_center)
+                    sdsUxMax = sx_center;
+
+                if (sdsUyMax < sy_center)
+                    sdsUyMax = sy_center;
+            }
+        }
+    }
 
-            std::cout << "rho_center: " <<  rho_center << std::endl;
-            std::cout << "kx * rho_flux_x: " <<  kx * rho_flux_x << std::endl;
-            std::cout << "ky * rho_flux_y: " <<  ky * rho_flux_y << std::endl;
-            std::cout << "rho.get1(k_center): " <<  rho.get1(k_center) << std::endl;
+    if (Fused) {
+        _SDS_uxmax[sds.getId()] = sdsUxMax;
+        _SDS_uymax[sds.getId()] = sdsUyMax;
+    }
+}
 
-            std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
-            std::cout << sds.getNumberBoundaryCells() << std::endl;
-            exitfail(1);
+template<unsigned int Lanes>
+void EulerRuO1::fluxDifferenceKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, 1> pressure = quantityMap.at("pressure")->view0<1>();
+    const QuantityView<real, 1> sx = quantityMap.at("sx")->view0<1>();
+    const QuantityView<real, 1> sy = quantityMap.at("sy")->view0<1>();
+
+    // Same flux differences as fluxKernel.
+    std::vector<real>& store = _fluxDifference[sds.getId()];
+    if (store.empty()) {
+        size_t nCells(0);
+        for (const auto& range: sds.getRanges())
+            nCells += range.length;
+        store.resize(nFluxDifferences * nCells);
+    }
+    real* __restrict flux = store.data();
+
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        size_t k_center = sds.convert(range.x, j);
+        for (int i = range.x; i < range.x + int(range.length); ++i, ++k_center, flux += nFluxDifferences) {
+            size_t k_bottom = sds.convert(i, j - 1);
+            size_t k_top = sds.convert(i, j + 1);
+            size_t k_left = sds.convert(i - 1, j);
+            size_t k_right = sds.convert(i + 1, j);
+
+            cellFluxDifferences(rho, rhou_x, rhou_y, rhoE, pressure, sx, sy,
+                    k_center, k_left, k_right, k_bottom, k_top, flux);
         }
+    }
+}
 
-        /*
-        if (rhou_y_flux_y > 0.) {
-            std::cout << "y";
-        }
+template<unsigned int Lanes, bool Fused>
+void EulerRuO1::fluxUpdateKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rho_next = quantityMap.at("rho")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x_next = quantityMap.at("rhou_x")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y_next = quantityMap.at("rhou_y")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE_next = quantityMap.at("rhoE")->view1<Lanes>();
+
+    // Fused sweep: pressure and speed of the new values (see fluxSpeed).
+    const QuantityView<real, 1> pressure_next = quantityMap.at("pressure")->view1<1>();
+    const QuantityView<real, 1> sx_next = quantityMap.at("sx")->view1<1>();
+    const QuantityView<real, 1> sy_next = quantityMap.at("sy")->view1<1>();
+    real sdsUxMax(Number::zero), sdsUyMax(Number::zero);
 
-        #ifndef NDEBUG
-        if (rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y < 0.) {
-            std::cout << "rhoE_center: " <<  rhoE_center << std::endl;
-            std::cout << "rhoE_flux_x: " <<  rhoE_flux_x << std::endl;
-            std::cout << "rhoE+1: " <<  rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y << std::endl;
+    // Same update as fluxKernel, hence the same results.
+    const real kx = Number::half * _dt / _dx;
+    const real ky = Number::half * _dt / _dy;
+    const real* __restrict flux = _fluxDifference[sds.getId()].data();
+
+    for (const auto& range: sds.getRanges()) {
+        size_t k_center = sds.convert(range.x, range.y);
+        for (unsigned int i = 0; i < range.length; ++i, ++k_center, flux += nFluxDifferences) {
+            rho_next[k_center] = rho[k_center] - kx * flux[0] - ky * flux[1];
+            rhou_x_next[k_center] = rhou_x[k_center] - kx * flux[2] - ky * flux[3];
+            rhou_y_next[k_center] = rhou_y[k_center] - kx * flux[4] - ky * flux[5];
+            rhoE_next[k_center] = rhoE[k_center] - kx * flux[6]  - ky * flux[7];
+
+            if (rho_next[k_center] < Number::zero) {
+                std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
+                std::cout << "rho_center: " <<  rho[k_center] << std::endl;
+                std::cout << "kx * rho_flux_x: " <<  kx * flux[0] << std::endl;
+                std::cout << "ky * rho_flux_y: " <<  ky * flux[1] << std::endl;
+                std::cout << "rho.get1(k_center): " <<  rho_next[k_center] << std::endl;
+                std::cout << _nIterations << " - i: " <<  range.x + int(i) << ", j:" << range.y << std::endl;
+                exitfail(1);
+            }
+
+            if (Fused) {
+                real sx_center, sy_center;
+                cellSpeed(rho_next[k_center], rhou_x_next[k_center], rhou_y_next[k_center], rhoE_next[k_center],
+                        pressure_next[k_center], sx_center, sy_center);
+                sx_next[k_center] = sx_center;
+                sy_next[k_center] = sy_center;
+
+                if (sdsUxMax < sx_center)
+                    sdsUxMax = sx_center;
+
+                if (sdsUyMax < sy_center)
+                    sdsUyMax = sy_center;
+            }
         }
-        #endif
-        */
+    }
+
+    if (Fused) {
+        _SDS_uxmax[sds.getId()] = sdsUxMax;
+        _SDS_uymax[sds.getId()] = sdsUyMax;
     }
 }
 
@@ -531,6 +880,15 @@ void EulerRuO1::updatePressure(const SDShared& sds, const std::map< std::string,
     // As a max, it's not necessary to update.
     // sds.updateBoundaryCells(quantityMap.at("sx"));
     // sds.updateBoundaryCells(quantityMap.at("sy"));
+
+    // The pressure arrays are switched by the fused sweep.
+    if (_fusedSweep)
+        sds.copyTimeVaryingCells(quantityMap.at("pressure"));
+}
+
+void EulerRuO1::updateBoundaries(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap) {
+    updateBoundary(sds, quantityMap);
+    updatePressure(sds, quantityMap);
 }
 
 void EulerRuO1::writeState(std::string directory) {
@@ -14,6 +14,14 @@
 #include "Domain.hpp"
 #include "Quantity.hpp"
 
+/*!
+ * Vectorised speed and flux (see eulerRuO1Simd.cpp), built with scons
+ * simd=avx2 or simd=avx512, which also disables FMA contraction.
+ */
+#if defined(PRECISION_DOUBLE) && defined(SIMD_KERNELS) && (defined(__AVX2__) || defined(__AVX512F__))
+#define EULERRUO1_SIMD
+#endif
+
 /*!
  * @brief Rusanov Order 1 scheme for the Euler hydrodynamics equations
  */
@@ -48,9 +56,114 @@ class EulerRuO1: public Engine {
     real computeSoundSpeed(const real& rho, const real& P);
     void speed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
     void flux(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief speed and flux on the layout of the conserved quantities:
+     * Lanes is 1 for SoA, Quantity::aosoaLanes for AoSoA.
+     */
+    template<unsigned int Lanes> void speedKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    template<unsigned int Lanes, bool Fused> void fluxKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief Fused sweep: flux, then pressure and speed of the new values
+     * in the next arrays of pressure, sx and sy, while they are in cache.
+     * Saves the speed sweep of the next iteration.
+     */
+    void fluxSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief Pipelined time step: the flux is computed in two sweeps.
+     * fluxDifference stores the flux differences of each cell, which don't
+     * depend on dt, while the maxima are reduced. fluxUpdate applies dt to
+     * them, fluxUpdateSpeed is its fused version (see fluxSpeed).
+     */
+    void fluxDifference(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    void fluxUpdate(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    void fluxUpdateSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    template<unsigned int Lanes> void fluxDifferenceKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    template<unsigned int Lanes, bool Fused> void fluxUpdateKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * flux differences of the cells of each SDS, in the order of its ranges:
+     * x and y differences of rho, rhou_x, rhou_y and rhoE.
+     */
+    std::vector< std::vector<real> > _fluxDifference;
+
+    /*!
+     * number of flux differences stored per cell
+     */
+    static const unsigned int nFluxDifferences = 8;
+
+    /*!
+     * @brief x and y flux differences of a cell, in the order of
+     * _fluxDifference, shared by fluxKernel and fluxDifferenceKernel so that
+     * both compute the same values.
+     */
+    template<unsigned int Lanes>
+    static void cellFluxDifferences(const QuantityView<real, Lanes>& rho, const QuantityView<real, Lanes>& rhou_x,
+            const QuantityView<real, Lanes>& rhou_y, const QuantityView<real, Lanes>& rhoE,
+            const QuantityView<real, 1>& pressure, const QuantityView<real, 1>& sx, const QuantityView<real, 1>& sy,
+            size_t k_center, size_t k_left, size_t k_right, size_t k_bottom, size_t k_top, real* __restrict flux);
+
+    /*!
+     * @brief pressure and wave speeds of a cell (zero in vacuum)
+     */
+    inline void cellSpeed(const real rho, const real rhou_x, const real rhou_y, const real rhoE,
+            real& pressure, real& sx, real& sy);
+
+    #ifdef EULERRUO1_SIMD
+    /*!
+     * @brief speed and flux on W cells at once, bit-identical to the scalar
+     * kernels. Only for row-major SoA quantities.
+     */
+    void speedSimd(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    template<bool Fused> void fluxSimd(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * true when the cells are stored row by row
+     */
+    bool _rowMajor;
+    #endif
     void updateBoundary(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
     void updatePressure(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
 
+    /*!
+     * @brief updateBoundary and updatePressure in one sweep, when the
+     * pressure was computed by the fused sweep.
+     */
+    void updateBoundaries(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
+
+    /*!
+     * true when the flux and the speed are computed in one sweep (exec
+     * option sweep=fused)
+     */
+    bool _fusedSweep;
+
+    /*!
+     * true when the interior SDSs are computed during the communication of
+     * the overlap cells (exec option halo=overlap)
+     */
+    bool _haloOverlap;
+
+    /*!
+     * true when dt is reduced and t broadcast after the reduction of the
+     * maxima (exec option dtReduction=agreed)
+     */
+    bool _agreedTimeStep;
+
+    /*!
+     * true when the maxima are reduced during the flux differences, dt
+     * being applied once known (exec option dtReduction=pipelined)
+     */
+    bool _pipelinedTimeStep;
+
+    /*!
+     * number of iterations between two exchanges of the overlap cells (exec
+     * option haloDepth), the ghost layers being computed redundantly in
+     * between
+     */
+    unsigned int _haloDepth;
+
     /*!
      * @brief Initialize transport upwind scheme engine
      *
@@ -69,6 +182,11 @@ class EulerRuO1: public Engine {
     // Scheme implementation
     void computeDT();
 
+    /*!
+     * @brief dt and t from the domain maxima, second half of computeDT.
+     */
+    void updateTimeStep();
+
     // Variables
     unsigned int _Nx;
     unsigned int _Ny;
@@ -0,0 +1,383 @@
+#include "eulerRuO1.hpp"
+
+#ifdef EULERRUO1_SIMD
+
+#include <immintrin.h>
+#include <iomanip>
+
+/*
+ * Vectorised speed and flux on row-major SoA quantities.
+ *
+ * Each operation of the scalar kernels is done in the same order on W cells
+ * at once: the results are bit-identical. Vacuum cells (rho == 0) and the
+ * clamp of the pressure are handled with masks. The last cells of a range
+ * are computed with masked loads and stores.
+ */
+namespace {
+
+#if defined(__AVX512F__)
+
+    typedef __m512d vreal;
+    typedef __mmask8 vmask;
+    const unsigned int W = 8;
+
+    inline vreal vset(real a) { return _mm512_set1_pd(a); }
+    inline vreal vadd(vreal a, vreal b) { return _mm512_add_pd(a, b); }
+    inline vreal vsub(vreal a, vreal b) { return _mm512_sub_pd(a, b); }
+    inline vreal vmul(vreal a, vreal b) { return _mm512_mul_pd(a, b); }
+    inline vreal vdiv(vreal a, vreal b) { return _mm512_div_pd(a, b); }
+    inline vreal vsqrt(vreal a) { return _mm512_sqrt_pd(a); }
+    inline vreal vabs(vreal a) { return _mm512_abs_pd(a); }
+    // Same as std::max(a, b): b if a < b, a otherwise.
+    inline vreal vmax(vreal a, vreal b) { return _mm512_max_pd(b, a); }
+    inline vmask veq(vreal a, vreal b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    inline vmask vlt(vreal a, vreal b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    inline vmask vand(vmask a, vmask b) { return a & b; }
+    // m ? a : b
+    inline vreal vselect(vmask m, vreal a, vreal b) { return _mm512_mask_blend_pd(m, b, a); }
+    inline bool vany(vmask m) { return m != 0; }
+
+    // Access to W consecutive cells.
+    struct Full {
+        inline vreal load(const real* p) const { return _mm512_loadu_pd(p); }
+        inline void store(real* p, vreal v) const { _mm512_storeu_pd(p, v); }
+        inline vmask active() const { return 0xff; }
+    };
+
+    // Access to the n < W first cells of W consecutive cells, the others
+    // read as zero (vacuum).
+    struct Tail {
+        explicit Tail(unsigned int n): _m((1u << n) - 1) {}
+        inline vreal load(const real* p) const { return _mm512_maskz_loadu_pd(_m, p); }
+        inline void store(real* p, vreal v) const { _mm512_mask_storeu_pd(p, _m, v); }
+        inline vmask active() const { return _m; }
+        vmask _m;
+    };
+
+#else
+
+    typedef __m256d vreal;
+    typedef __m256d vmask;
+    const unsigned int W = 4;
+
+    inline vreal vset(real a) { return _mm256_set1_pd(a); }
+    inline vreal vadd(vreal a, vreal b) { return _mm256_add_pd(a, b); }
+    inline vreal vsub(vreal a, vreal b) { return _mm256_sub_pd(a, b); }
+    inline vreal vmul(vreal a, vreal b) { return _mm256_mul_pd(a, b); }
+    inline vreal vdiv(vreal a, vreal b) { return _mm256_div_pd(a, b); }
+    inline vreal vsqrt(vreal a) { return _mm256_sqrt_pd(a); }
+    inline vreal vabs(vreal a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    // Same as std::max(a, b): b if a < b, a otherwise.
+    inline vreal vmax(vreal a, vreal b) { return _mm256_max_pd(b, a); }
+    inline vmask veq(vreal a, vreal b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    inline vmask vlt(vreal a, vreal b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    inline vmask vand(vmask a, vmask b) { return _mm256_and_pd(a, b); }
+    // m ? a : b
+    inline vreal vselect(vmask m, vreal a, vreal b) { return _mm256_blendv_pd(b, a, m); }
+    inline bool vany(vmask m) { return _mm256_movemask_pd(m) != 0; }
+
+    struct Full {
+        inline vreal load(const real* p) const { return _mm256_loadu_pd(p); }
+        inline void store(real* p, vreal v) const { _mm256_storeu_pd(p, v); }
+        inline vmask active() const { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+    };
+
+    struct Tail {
+        explicit Tail(unsigned int n):
+            _m(_mm256_cmpgt_epi64(_mm256_set1_epi64x(n), _mm256_set_epi64x(3, 2, 1, 0))) {}
+        inline vreal load(const real* p) const { return _mm256_maskload_pd(p, _m); }
+        inline void store(real* p, vreal v) const { _mm256_maskstore_pd(p, _m, v); }
+        inline vmask active() const { return _mm256_castsi256_pd(_m); }
+        __m256i _m;
+    };
+
+#endif
+
+    struct SpeedData {
+        const real* __restrict rho;
+        const real* __restrict rhou_x;
+        const real* __restrict rhou_y;
+        const real* __restrict rhoE;
+        real* __restrict pressure;
+        real* __restrict sx;
+        real* __restrict sy;
+        vreal gamma;
+        vreal gammaMinusOne;
+    };
+
+    // Pressure and wave speeds of W cells, stored at k.
+    template<typename Access>
+    inline void cellSpeed(const Access& a, vreal gamma, vreal gammaMinusOne,
+            vreal rho_center, vreal rhou_x_center, vreal rhou_y_center, vreal rhoE_center,
+            real* __restrict pressure, real* __restrict sx, real* __restrict sy, size_t k,
+            vreal& uxMax, vreal& uyMax) {
+        const vreal zero = vset(Number::zero);
+        const vmask vacuum = veq(rho_center, zero);
+
+        const vreal ux = vdiv(rhou_x_center, rho_center);
+        const vreal uy = vdiv(rhou_y_center, rho_center);
+        const vreal Ek = vmul(vset(Number::half), vadd(vmul(ux, rhou_x_center), vmul(uy, rhou_y_center)));
+
+        // computePressure
+        vreal P = vmul(gammaMinusOne, vsub(rhoE_center, Ek));
+        P = vselect(vlt(P, zero), zero, P);
+
+        // computeSoundSpeed
+        const vreal c = vsqrt(vdiv(vmul(gamma, P), rho_center));
+
+        const vreal sx_center = vselect(vacuum, zero, vmax(vabs(vadd(ux, c)), vabs(vsub(ux, c))));
+        const vreal sy_center = vselect(vacuum, zero, vmax(vabs(vadd(uy, c)), vabs(vsub(uy, c))));
+
+        a.store(pressure + k, vselect(vacuum, zero, P));
+        a.store(sx + k, sx_center);
+        a.store(sy + k, sy_center);
+
+        uxMax = vmax(uxMax, sx_center);
+        uyMax = vmax(uyMax, sy_center);
+    }
+
+    template<typename Access>
+    inline void speedCells(const Access& a, const SpeedData& d, size_t k, vreal& uxMax, vreal& uyMax) {
+        cellSpeed(a, d.gamma, d.gammaMinusOne,
+                a.load(d.rho + k), a.load(d.rhou_x + k), a.load(d.rhou_y + k), a.load(d.rhoE + k),
+                d.pressure, d.sx, d.sy, k, uxMax, uyMax);
+    }
+
+    // Same as the scalar loop: keeps the first of the largest values.
+    inline real hmax(vreal v) {
+        alignas(64) real lanes[W];
+        #if defined(__AVX512F__)
+        _mm512_store_pd(lanes, v);
+        #else
+        _mm256_store_pd(lanes, v);
+        #endif
+        real m = Number::zero;
+        for (unsigned int l = 0; l < W; ++l) {
+            if (m < lanes[l])
+                m = lanes[l];
+        }
+        return m;
+    }
+
+    struct FluxData {
+        const real* __restrict rho;
+        real* __restrict rho_next;
+        const real* __restrict rhou_x;
+        real* __restrict rhou_x_next;
+        const real* __restrict rhou_y;
+        real* __restrict rhou_y_next;
+        const real* __restrict rhoE;
+        real* __restrict rhoE_next;
+        const real* __restrict pressure;
+        const real* __restrict sx;
+        const real* __restrict sy;
+        vreal kx;
+        vreal ky;
+
+        // Fused sweep
+        real* __restrict pressure_next;
+        real* __restrict sx_next;
+        real* __restrict sy_next;
+        vreal gamma;
+        vreal gammaMinusOne;
+    };
+
+    /*
+     * Returns the mask of the cells whose next rho is negative.
+     */
+    template<bool Fused, typename Access>
+    inline vmask fluxCells(const Access& a, const FluxData& d, size_t k_center, size_t k_top, size_t k_bottom,
+            vreal& uxMax, vreal& uyMax) {
+        const vreal zero = vset(Number::zero);
+        const size_t k_left = k_center - 1;
+        const size_t k_right = k_center + 1;
+
+        const vreal rho_left = a.load(d.rho + k_left);
+        const vreal rho_center = a.load(d.rho + k_center);
+        const vreal rho_right = a.load(d.rho + k_right);
+        const vreal rho_top = a.load(d.rho + k_top);
+        const vreal rho_bottom = a.load(d.rho + k_bottom);
+
+        const vreal rhou_x_left = a.load(d.rhou_x + k_left);
+        const vreal rhou_x_center = a.load(d.rhou_x + k_center);
+        const vreal rhou_x_right = a.load(d.rhou_x + k_right);
+        const vreal rhou_x_top = a.load(d.rhou_x + k_top);
+        const vreal rhou_x_bottom = a.load(d.rhou_x + k_bottom);
+
+        const vreal rhou_y_left = a.load(d.rhou_y + k_left);
+        const vreal rhou_y_center = a.load(d.rhou_y + k_center);
+        const vreal rhou_y_right = a.load(d.rhou_y + k_right);
+        const vreal rhou_y_top = a.load(d.rhou_y + k_top);
+        const vreal rhou_y_bottom = a.load(d.rhou_y + k_bottom);
+
+        const vreal rhoE_left = a.load(d.rhoE + k_left);
+        const vreal rhoE_center = a.load(d.rhoE + k_center);
+        const vreal rhoE_right = a.load(d.rhoE + k_right);
+        const vreal rhoE_top = a.load(d.rhoE + k_top);
+        const vreal rhoE_bottom = a.load(d.rhoE + k_bottom);
+
+        const vreal cell_sx_center = a.load(d.sx + k_center);
+        const vreal sx_left = vmax(a.load(d.sx + k_left), cell_sx_center);
+        const vreal sx_right = vmax(a.load(d.sx + k_right), cell_sx_center);
+
+        const vreal cell_sy_center = a.load(d.sy + k_center);
+        const vreal sy_top = vmax(a.load(d.sy + k_top), cell_sy_center);
+        const vreal sy_bottom = vmax(a.load(d.sy + k_bottom), cell_sy_center);
+
+        const vreal ux_left = vselect(veq(rho_left, zero), zero, vdiv(rhou_x_left, rho_left));
+        const vreal ux_right = vselect(veq(rho_right, zero), zero, vdiv(rhou_x_right, rho_right));
+        const vreal uy_top = vselect(veq(rho_top, zero), zero, vdiv(rhou_y_top, rho_top));
+        const vreal uy_bottom = vselect(veq(rho_bottom, zero), zero, vdiv(rhou_y_bottom, rho_bottom));
+
+        const vreal pressure_left = a.load(d.pressure + k_left);
+        const vreal pressure_right = a.load(d.pressure + k_right);
+        const vreal pressure_top = a.load(d.pressure + k_top);
+        const vreal pressure_bottom = a.load(d.pressure + k_bottom);
+
+        // Horizontal flux
+        const vreal rho_flux_x = vadd(vsub(vsub(rhou_x_right, rhou_x_left),
+                    vmul(sx_right, vsub(rho_right, rho_center))),
+                vmul(sx_left, vsub(rho_center, rho_left)));
+
+        const vreal rhou_x_flux_x = vadd(vsub(vsub(vsub(vadd(vmul(ux_right, rhou_x_right), pressure_right),
+                            vmul(ux_left, rhou_x_left)), pressure_left),
+                    vmul(sx_right, vsub(rhou_x_right, rhou_x_center))),
+                vmul(sx_left, vsub(rhou_x_center, rhou_x_left)));
+
+        const vreal rhou_y_flux_x = vadd(vsub(vsub(vmul(ux_right, rhou_y_right), vmul(ux_left, rhou_y_left)),
+                    vmul(sx_right, vsub(rhou_y_right, rhou_y_center))),
+                vmul(sx_left, vsub(rhou_y_center, rhou_y_left)));
+
+        const vreal rhoE_flux_x = vadd(vsub(vsub(vmul(vadd(rhoE_right, pressure_right), ux_right),
+                        vmul(vadd(rhoE_left, pressure_left), ux_left)),
+                    vmul(sx_right, vsub(rhoE_right, rhoE_center))),
+                vmul(sx_left, vsub(rhoE_center, rhoE_left)));
+
+        // Vertical flux
+        const vreal rho_flux_y = vadd(vsub(vsub(rhou_y_top, rhou_y_bottom),
+                    vmul(sy_top, vsub(rho_top, rho_center))),
+                vmul(sy_bottom, vsub(rho_center, rho_bottom)));
+
+        const vreal rhou_x_flux_y = vadd(vsub(vsub(vmul(rhou_x_top, uy_top), vmul(rhou_x_bottom, uy_bottom)),
+                    vmul(sy_top, vsub(rhou_x_top, rhou_x_center))),
+                vmul(sy_bottom, vsub(rhou_x_center, rhou_x_bottom)));
+
+        const vreal rhou_y_flux_y = vadd(vsub(vsub(vsub(vadd(vmul(uy_top, rhou_y_top), pressure_top),
+                            vmul(uy_bottom, rhou_y_bottom)), pressure_bottom),
+                    vmul(sy_top, vsub(rhou_y_top, rhou_y_center))),
+                vmul(sy_bottom, vsub(rhou_y_center, rhou_y_bottom)));
+
+        const vreal rhoE_flux_y = vadd(vsub(vsub(vmul(vadd(rhoE_top, pressure_top), uy_top),
+                        vmul(vadd(rhoE_bottom, pressure_bottom), uy_bottom)),
+                    vmul(sy_top, vsub(rhoE_top, rhoE_center))),
+                vmul(sy_bottom, vsub(rhoE_center, rhoE_bottom)));
+
+        // Set new values.
+        const vreal rho_new = vsub(vsub(rho_center, vmul(d.kx, rho_flux_x)), vmul(d.ky, rho_flux_y));
+        const vreal rhou_x_new = vsub(vsub(rhou_x_center, vmul(d.kx, rhou_x_flux_x)), vmul(d.ky, rhou_x_flux_y));
+        const vreal rhou_y_new = vsub(vsub(rhou_y_center, vmul(d.kx, rhou_y_flux_x)), vmul(d.ky, rhou_y_flux_y));
+        const vreal rhoE_new = vsub(vsub(rhoE_center, vmul(d.kx, rhoE_flux_x)), vmul(d.ky, rhoE_flux_y));
+        a.store(d.rho_next + k_center, rho_new);
+        a.store(d.rhou_x_next + k_center, rhou_x_new);
+        a.store(d.rhou_y_next + k_center, rhou_y_new);
+        a.store(d.rhoE_next + k_center, rhoE_new);
+
+        if (Fused)
+            cellSpeed(a, d.gamma, d.gammaMinusOne, rho_new, rhou_x_new, rhou_y_new, rhoE_new,
+                    d.pressure_next, d.sx_next, d.sy_next, k_center, uxMax, uyMax);
+
+        return vand(vlt(rho_new, zero), a.active());
+    }
+}
+
+void EulerRuO1::speedSimd(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    SpeedData d;
+    d.rho = quantityMap.at("rho")->data0();
+    d.rhou_x = quantityMap.at("rhou_x")->data0();
+    d.rhou_y = quantityMap.at("rhou_y")->data0();
+    d.rhoE = quantityMap.at("rhoE")->data0();
+    d.pressure = quantityMap.at("pressure")->data0();
+    d.sx = quantityMap.at("sx")->data0();
+    d.sy = quantityMap.at("sy")->data0();
+    d.gamma = vset(_gamma);
+    d.gammaMinusOne = vset(_gamma - Number::unit);
+
+    vreal uxMax = vset(Number::zero);
+    vreal uyMax = vset(Number::zero);
+    for (const auto& range: sds.getRanges()) {
+        size_t k = sds.convert(range.x, range.y);
+        const size_t k_end = k + range.length;
+        for (; k + W <= k_end; k += W)
+            speedCells(Full(), d, k, uxMax, uyMax);
+        if (k < k_end)
+            speedCells(Tail(k_end - k), d, k, uxMax, uyMax);
+    }
+
+    // Updating umax and uymax (not for the ghost layers of the deep halo)
+    if (sds.getId() < _SDS_uxmax.size()) {
+        _SDS_uxmax[sds.getId()] = hmax(uxMax);
+        _SDS_uymax[sds.getId()] = hmax(uyMax);
+    }
+}
+
+template<bool Fused>
+void EulerRuO1::fluxSimd(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    FluxData d;
+    d.rho = quantityMap.at("rho")->data0();
+    d.rho_next = quantityMap.at("rho")->data1();
+    d.rhou_x = quantityMap.at("rhou_x")->data0();
+    d.rhou_x_next = quantityMap.at("rhou_x")->data1();
+    d.rhou_y = quantityMap.at("rhou_y")->data0();
+    d.rhou_y_next = quantityMap.at("rhou_y")->data1();
+    d.rhoE = quantityMap.at("rhoE")->data0();
+    d.rhoE_next = quantityMap.at("rhoE")->data1();
+    d.pressure = quantityMap.at("pressure")->data0();
+    d.sx = quantityMap.at("sx")->data0();
+    d.sy = quantityMap.at("sy")->data0();
+    d.kx = vset(Number::half * _dt / _dx);
+    d.ky = vset(Number::half * _dt / _dy);
+    d.pressure_next = quantityMap.at("pressure")->data1();
+    d.sx_next = quantityMap.at("sx")->data1();
+    d.sy_next = quantityMap.at("sy")->data1();
+    d.gamma = vset(_gamma);
+    d.gammaMinusOne = vset(_gamma - Number::unit);
+
+    vreal uxMax = vset(Number::zero);
+    vreal uyMax = vset(Number::zero);
+
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        size_t k_center = sds.convert(range.x, j);
+        size_t k_top = sds.convert(range.x, j + 1);
+        size_t k_bottom = sds.convert(range.x, j - 1);
+        const size_t k_end = k_center + range.length;
+        bool negative(false);
+        for (; k_center + W <= k_end; k_center += W, k_top += W, k_bottom += W)
+            negative |= vany(fluxCells<Fused>(Full(), d, k_center, k_top, k_bottom, uxMax, uyMax));
+        if (k_center < k_end)
+            negative |= vany(fluxCells<Fused>(Tail(k_end - k_center), d, k_center, k_top, k_bottom, uxMax, uyMax));
+
+        if (negative) {
+            const size_t k_begin = sds.convert(range.x, j);
+            for (unsigned int i = 0; i < range.length; ++i) {
+                if (d.rho_next[k_begin + i] < Number::zero) {
+                    std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
+                    std::cout << "rho.get1(k_center): " << d.rho_next[k_begin + i] << std::endl;
+                    std::cout << _nIterations << " - i: " << range.x + int(i) << ", j:" << j << std::endl;
+                    std::cout << sds.getNumberBoundaryCells() << std::endl;
+                    exitfail(1);
+                }
+            }
+        }
+    }
+
+    if (Fused) {
+        _SDS_uxmax[sds.getId()] = hmax(uxMax);
+        _SDS_uymax[sds.getId()] = hmax(uyMax);
+    }
+}
+
+template void EulerRuO1::fluxSimd<false>(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+template void EulerRuO1::fluxSimd<true>(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+#endif
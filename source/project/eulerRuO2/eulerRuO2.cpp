@@ -36,8 +36,34 @@ int EulerRuO2::init() {
     IO::loadExecOptions(_initpath, *_domain);
     IO::loadSDDInfo(_initpath, *_domain);
 
+    // The second order stencils below step through memory by +/-1 and +/-2.
+    if (_domain->getExecOption("cellOrder", CoordConverter::ROW_MAJOR) != CoordConverter::ROW_MAJOR)
+        exitfail("EulerRuO2 only works with the row-major cell order.");
+
     // Now that the subdomains info were loaded they can be built
-    _domain->buildSubDomainsMPI(4, 1);
+    _timerSetup.begin();
+    _domain->buildSubDomainsMPI(4, 1, 7);
+    _timerSetup.end();
+
+    // "fused": the speed of the next iteration is computed by the flux.
+    const std::string sweep(_domain->getExecOption("sweep", "split"));
+    if (sweep != "split" && sweep != "fused")
+        exitfail("Unknown sweep: " + sweep);
+    _fusedSweep = (sweep == "fused");
+
+    // "overlap": the flux of the SDSs far from the overlap cells is computed
+    // during the communications.
+    const std::string halo(_domain->getExecOption("halo", "blocking"));
+    if (halo != "blocking" && halo != "overlap")
+        exitfail("Unknown halo: " + halo);
+    _haloOverlap = (halo == "overlap");
+
+    // "agreed": the SDDs agree on dt and t with extra collectives, for
+    // rounding modes that are not deterministic (random rounding of verrou).
+    const std::string dtReduction(_domain->getExecOption("dtReduction", "single"));
+    if (dtReduction != "single" && dtReduction != "agreed")
+        exitfail("Unknown dt reduction: " + dtReduction);
+    _agreedTimeStep = (dtReduction == "agreed");
 
     // build SDS in each SDD.
     _domain->buildThreads();
@@ -46,8 +72,9 @@ int EulerRuO2::init() {
     if (_MPI_rank == 0)
         _domain->showInfo();
 
-    // Initial time and error.
+    // Initial time, error and iteration.
     _t = 0.; _t_err = 0.;
+    _nIterations = 0;
 
     // Initial last.
     _last_dt = -1.0;
@@ -55,20 +82,25 @@ int EulerRuO2::init() {
     // Initial min.
     _min_dt = std::numeric_limits<real>::max();
 
+    // The conserved quantities are read and written together by the flux.
+    _domain->addQuantityGroup({"rho", "rhou_x", "rhou_y", "rhoE"});
+
     // Loading initial values
-    IO::loadQuantity(_initpath, "rho", *_domain);
-    IO::loadQuantity(_initpath, "rhou_x", *_domain);
-    IO::loadQuantity(_initpath, "rhou_y", *_domain);
-    IO::loadQuantity(_initpath, "rhoE", *_domain);
-    IO::loadQuantity(_initpath, "pressure", *_domain);
-    IO::loadQuantity(_initpath, "sx", *_domain);
-    IO::loadQuantity(_initpath, "sy", *_domain);
+    loadQuantity(*_domain, "rho");
+    loadQuantity(*_domain, "rhou_x");
+    loadQuantity(*_domain, "rhou_y");
+    loadQuantity(*_domain, "rhoE");
+    loadQuantity(*_domain, "pressure");
+    loadQuantity(*_domain, "sx");
+    loadQuantity(*_domain, "sy");
 
     // Loading boundary conditions on \rho and \rhoE
     IO::loadBoundaryConditions(_initpath, *_domain);
 
     // Build communication maps between sdds (overlap and boundary).
+    _timerSetup.begin();
     _domain->buildCommunicationMap();
+    _timerSetup.end();
 
     unsigned int nSDS = _domain->getNumberSDS();
     _SDS_uxmax.resize(nSDS);
@@ -83,12 +115,30 @@ int EulerRuO2::init() {
     _domain->addEquation("flux", std::bind(&EulerRuO2::flux, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
+    if (_haloOverlap) {
+        _domain->addSplitEquation("flux", std::bind(&EulerRuO2::flux, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+        if (_fusedSweep)
+            _domain->addSplitEquation("fluxSpeed", std::bind(&EulerRuO2::fluxSpeed, this,
+                                           std::placeholders::_1, std::placeholders::_2));
+    }
+
     _domain->addEquation("updateBoundary", std::bind(&EulerRuO2::updateBoundary, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
     _domain->addEquation("updatePressure", std::bind(&EulerRuO2::updatePressure, this,
                                    std::placeholders::_1, std::placeholders::_2));
 
+    if (_fusedSweep) {
+        _domain->addEquation("fluxSpeed", std::bind(&EulerRuO2::fluxSpeed, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+
+        _domain->addEquation("updateBoundaries", std::bind(&EulerRuO2::updateBoundaries, this,
+                                       std::placeholders::_1, std::placeholders::_2));
+    }
+
+    initSnapshots(*_domain, {"rho", "rhou_x", "rhou_y", "rhoE"});
+    initCheckpoints(*_domain, {&_dt, &_t_err, &_last_dt, &_min_dt});
     return 0;
 }
 
@@ -101,7 +151,7 @@ int EulerRuO2::start() {
     MPI_Barrier(MPI_COMM_WORLD);
     #endif
 
-    _nIterations = 0;
+    bool speedDone(false);
     while (_t < _T) {
         printStatus();
 
@@ -111,42 +161,79 @@ int EulerRuO2::start() {
 
         ++_nIterations;
 
-        // Compute pressure and speed.
-        _domain->execEquation("updateBoundary");
-        
-        // ----------------------------------------------------------------------
-        // (with a stencil of one, it's not required here because there is no overlap/boundary cell needed in the computation).
-   	    /* _timerComputation.end();
-        _domain->updateOverlapCells();
-        _timerComputation.begin(); */
-        // ----------------------------------------------------------------------
-
-        // Compute interface speed and pressure in cell.
-        _domain->execEquation("speed");
-
-        // Copy the pressure value in boundary.
-        _domain->execEquation("updatePressure");
-
-        // ----------------------------------------------------------------------
-        // Communicate the fluxes computed.
-   	    _timerComputation.end();
-        _domain->updateOverlapCells();
-        computeDT();
-        _timerComputation.begin();
-        // ----------------------------------------------------------------------
+        if (speedDone) {
+            // Pressure and speed were computed by the last sweep.
+            _domain->execEquation("updateBoundaries");
+        } else {
+            // Compute pressure and speed.
+            _domain->execEquation("updateBoundary");
+
+            // ----------------------------------------------------------------------
+            // (with a stencil of one, it's not required here because there is no overlap/boundary cell needed in the computation).
+            /* _timerComputation.end();
+            _domain->updateOverlapCells();
+            _timerComputation.begin(); */
+            // ----------------------------------------------------------------------
+
+            // Compute interface speed and pressure in cell.
+            _domain->execEquation("speed");
+
+            // Copy the pressure value in boundary.
+            _domain->execEquation("updatePressure");
+        }
 
-        // Start works on this equation
-        _domain->execEquation("flux");
+        if (_haloOverlap) {
+            // Post the communications, the interior SDSs don't read the
+            // overlap cells and are computed while they are in flight.
+            _domain->startOverlapCells();
+            computeDT();
+
+            speedDone = _fusedSweep && _t < _T;
+            const std::string fluxEquation(speedDone ? "fluxSpeed" : "flux");
+            _domain->execInteriorEquation(fluxEquation);
+
+            // ----------------------------------------------------------------------
+            _timerComputation.end();
+            _domain->finishOverlapCells();
+            _timerComputation.begin();
+            // ----------------------------------------------------------------------
+
+            _domain->execBorderEquation(fluxEquation);
+        } else {
+            // ----------------------------------------------------------------------
+            // Communicate the fluxes computed.
+            _timerComputation.end();
+            _domain->updateOverlapCells();
+            computeDT();
+            _timerComputation.begin();
+            // ----------------------------------------------------------------------
+
+            // Start works on this equation, the fused sweep also computes the
+            // pressure and speed of the new values (but for the last iteration).
+            speedDone = _fusedSweep && _t < _T;
+            if (speedDone)
+                _domain->execEquation("fluxSpeed");
+            else
+                _domain->execEquation("flux");
+        }
 
         _domain->switchQuantityPrevNext("rho");
         _domain->switchQuantityPrevNext("rhou_x");
         _domain->switchQuantityPrevNext("rhou_y");
         _domain->switchQuantityPrevNext("rhoE");
+
+        if (speedDone) {
+            _domain->switchQuantityPrevNext("pressure");
+            _domain->switchQuantityPrevNext("sx");
+            _domain->switchQuantityPrevNext("sy");
+        }
         //std::cout << "nouvelle iteratioooooooooooooooooooooon" << std::endl;
 //        if (_nIterations==1){        exitfail(1);}
    	    _timerComputation.end();
         // ----------------------------------------------------------------------
+        snapshot();
         _timerIteration.end();
+        checkpoint();
     }
     printStatus(true);
     return 0;
@@ -155,22 +242,19 @@ int EulerRuO2::start() {
 // Updating according to CFL and max velocity
 void EulerRuO2::computeDT() {
 
-    if (_Ny == 1) {
-        _SDD_uxmax = *std::max_element(_SDS_uxmax.begin(), _SDS_uxmax.end());
-        _dt = _CFL * _dx / _SDD_uxmax;
-    }
+    // The only collective of the step: the maxima are exact, so every SDD
+    // computes the same dt and t from them.
+    updateDomainUmax();
 
-    if (_Nx == 1) {
-        _SDD_uymax = *std::max_element(_SDS_uymax.begin(), _SDS_uymax.end());
-        _dt = _CFL * _dy / _SDD_uymax;
-    }
+    if (_Ny == 1)
+        _dt = _CFL * _dx / _Domain_uxmax;
+
+    if (_Nx == 1)
+        _dt = _CFL * _dy / _Domain_uymax;
 
     // Real formula in two dimensions
-    if (_Nx > 1 && _Ny > 1) {
-        // We need the max above all to be reproducible.
-        updateDomainUmax();
+    if (_Nx > 1 && _Ny > 1)
         _dt = _CFL * _dx * _dy / (_Domain_uxmax * _dy + _Domain_uymax * _dx);
-    }
 
     // Max increase.
     /*
@@ -183,7 +267,8 @@ void EulerRuO2::computeDT() {
 
     // If the computation is set with random rounding error, the dt may differ among the sub-domains.
     // To ensure the computation (and also the number of iteration), we must communicate it.
-    _dt = reduceMin(_dt);
+    if (_agreedTimeStep)
+        _dt = reduceMin(_dt);
 
     #ifndef NDEBUG
     // Show if dt drops.
@@ -204,13 +289,14 @@ void EulerRuO2::computeDT() {
     #endif
 
     // add timestep to global time.
-    if (_MPI_rank == 0) {
+    if (!_agreedTimeStep || _MPI_rank == 0) {
         real y = _dt + _t_err;
         Number::fastTwoSum(_t, y, _t, _t_err);
     }
 
     #ifndef SEQUENTIAL
-    MPI_Bcast(&_t, 1, MPI_REALTYPE, 0, MPI_COMM_WORLD);
+    if (_agreedTimeStep)
+        MPI_Bcast(&_t, 1, MPI_REALTYPE, 0, MPI_COMM_WORLD);
     #endif
 
     // Store current dt
@@ -259,14 +345,49 @@ real EulerRuO2::computeSoundSpeed(const real& rho, const real& P) {
     return c;
 }
 
+void EulerRuO2::cellSpeed(const real rho_center, const real rhou_x_center, const real rhou_y_center, const real rhoE_center,
+        real& pressure_center, real& sx_center, real& sy_center) {
+
+    if (rho_center == Number::zero) {
+        pressure_center = Number::zero;
+        sx_center = Number::zero;
+        sy_center = Number::zero;
+        return;
+    }
+
+    // This should never be negative of course.
+    assert(rho_center > 0.);
+
+    const real ux = rhou_x_center / rho_center;
+    const real uy = rhou_y_center / rho_center;
+    const real Ek = Number::half * (ux * rhou_x_center + uy * rhou_y_center);
+    pressure_center = computePressure(Ek, rhoE_center);
+    const real c = computeSoundSpeed(rho_center, pressure_center);
+
+    sx_center = std::max(rabs(ux + c), rabs(ux - c));
+    sy_center = std::max(rabs(uy + c), rabs(uy - c));
+}
+
 void EulerRuO2::speed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
-    Quantity<real>& rho = *quantityMap.at("rho");
-    Quantity<real>& rhou_x = *quantityMap.at("rhou_x");
-    Quantity<real>& rhou_y = *quantityMap.at("rhou_y");
-    Quantity<real>& rhoE = *quantityMap.at("rhoE");
-    Quantity<real>& pressure = *quantityMap.at("pressure");
-    Quantity<real>& sx = *quantityMap.at("sx");
-    Quantity<real>& sy = *quantityMap.at("sy");
+    // The layout of the conserved quantities is the same for the group.
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        speedKernel<1>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        speedKernel<Quantity<real>::aosoaLanes>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO2::speed.");
+}
+
+template<unsigned int Lanes>
+void EulerRuO2::speedKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, 1> pressure = quantityMap.at("pressure")->view0<1>();
+    const QuantityView<real, 1> sx = quantityMap.at("sx")->view0<1>();
+    const QuantityView<real, 1> sy = quantityMap.at("sy")->view0<1>();
 
     // P = gamma * (gamma - 1.) * rho * e
     // c = sqrt(gamma * P / rho);
@@ -276,44 +397,21 @@ void EulerRuO2::speed(const SDShared& sds, const std::map< std::string, Quantity
     // s_y = a^n_{i, j+1/2} = max(max(|u_y^n_{i,j} + c^n_{i,j}|, |u_y^n_{i,j} - c^n_{i,j}|), max(|u_y^n_{i,j+1} + c^n_{i,j+1}|, |u_y^n_{i,j+1} - c^n_{i,j+1}|))
 
     real sdsUxMax(Number::zero), sdsUyMax(Number::zero);
-    for (const auto& coords: sds) {
-        const int i = coords.first;
-        const int j = coords.second;
-        size_t k_center = sds.convert(i, j);
-
-        const real rho_center = rho.get0(k_center);
-        if (rho_center == Number::zero) {
-            pressure.set0(Number::zero, k_center);
-            sx.set0(Number::zero, k_center);
-            sy.set0(Number::zero, k_center);
-            continue;
+    for (const auto& range: sds.getRanges()) {
+        size_t k_center = sds.convert(range.x, range.y);
+        for (unsigned int i = 0; i < range.length; ++i, ++k_center) {
+            real sx_center, sy_center;
+            cellSpeed(rho[k_center], rhou_x[k_center], rhou_y[k_center], rhoE[k_center],
+                    pressure[k_center], sx_center, sy_center);
+            sx[k_center] = sx_center;
+            sy[k_center] = sy_center;
+
+            if (sdsUxMax < sx_center)
+                sdsUxMax = sx_center;
+
+            if (sdsUyMax < sy_center)
+                sdsUyMax = sy_center;
         }
-
-        // This should never be negative of course.
-        assert(rho_center > 0.);
-
-        const real rhou_x_center = rhou_x.get0(k_center);
-        const real rhou_y_center = rhou_y.get0(k_center);
-        const real rhoE_center = rhoE.get0(k_center);
-
-        const real ux = rhou_x_center / rho_center;
-        const real uy = rhou_y_center / rho_center;
-        const real Ek = Number::half * (ux * rhou_x_center + uy * rhou_y_center);
-        const real pressure_center = computePressure(Ek, rhoE_center);
-        pressure.set0(pressure_center, k_center);
-        const real c = computeSoundSpeed(rho_center, pressure_center);
-
-        const real sx_center = std::max(rabs(ux + c), rabs(ux - c));
-        sx.set0(sx_center, k_center);
-
-        const real sy_center = std::max(rabs(uy + c), rabs(uy - c));
-        sy.set0(sy_center, k_center);
-
-        if (sdsUxMax < sx_center)
-            sdsUxMax = sx_center;
-
-        if (sdsUyMax < sy_center)
-            sdsUyMax = sy_center;
     }
 
     // Updating umax and uymax
@@ -332,14 +430,47 @@ real EulerRuO2::minmod(real a, real b) {
 
 
 void EulerRuO2::flux(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        fluxKernel<1, false>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxKernel<Quantity<real>::aosoaLanes, false>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO2::flux.");
+}
+
+void EulerRuO2::fluxSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+    const unsigned int lanes = quantityMap.at("rho")->getLanes();
+    if (lanes == 1)
+        fluxKernel<1, true>(sds, quantityMap);
+    else if (lanes == Quantity<real>::aosoaLanes)
+        fluxKernel<Quantity<real>::aosoaLanes, true>(sds, quantityMap);
+    else
+        exitfail("Unsupported number of lanes in EulerRuO2::fluxSpeed.");
+}
+
+template<unsigned int Lanes, bool Fused>
+void EulerRuO2::fluxKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap) {
+
+    // Fused sweep: pressure and speed of the new values (see fluxSpeed).
+    real sdsUxMax(Number::zero), sdsUyMax(Number::zero);
 
-    Quantity<real>& rho = *quantityMap.at("rho");
-    Quantity<real>& rhou_x = *quantityMap.at("rhou_x");
-    Quantity<real>& rhou_y = *quantityMap.at("rhou_y");
-    Quantity<real>& rhoE = *quantityMap.at("rhoE");
-    Quantity<real>& pressure = *quantityMap.at("pressure");
-    Quantity<real>& sx = *quantityMap.at("sx");
-    Quantity<real>& sy = *quantityMap.at("sy");
+    const QuantityView<real, Lanes> rho = quantityMap.at("rho")->view0<Lanes>();
+    const QuantityView<real, Lanes> rho_next = quantityMap.at("rho")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_x = quantityMap.at("rhou_x")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_x_next = quantityMap.at("rhou_x")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhou_y = quantityMap.at("rhou_y")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhou_y_next = quantityMap.at("rhou_y")->view1<Lanes>();
+    const QuantityView<real, Lanes> rhoE = quantityMap.at("rhoE")->view0<Lanes>();
+    const QuantityView<real, Lanes> rhoE_next = quantityMap.at("rhoE")->view1<Lanes>();
+    const QuantityView<real, 1> pressure = quantityMap.at("pressure")->view0<1>();
+    const QuantityView<real, 1> sx = quantityMap.at("sx")->view0<1>();
+    const QuantityView<real, 1> sy = quantityMap.at("sy")->view0<1>();
+
+    // Only written by the fused sweep.
+    const QuantityView<real, 1> pressure_next = quantityMap.at("pressure")->view1<1>();
+    const QuantityView<real, 1> sx_next = quantityMap.at("sx")->view1<1>();
+    const QuantityView<real, 1> sy_next = quantityMap.at("sy")->view1<1>();
 
     // U^{n+1}_{i,j} = U^n_{i,j} - dt / dx * (F^n_{i+1/2, j} - F^n_{i-1/2, j}) - dt / dy * (G^n_{i, j+1/2} - G^n_{i, j-1/2})
     // U^{n+1}_{i,j} = U^n_{i,j} - dt / dx * (F^n_x) - dt / dy * (G^n_y)
@@ -370,510 +501,522 @@ void EulerRuO2::flux(const SDShared& sds, const std::map< std::string, Quantity<
     //const real ky = Number::half * _dt / _dy;
     // std::cout << "dt = " << _dt << "dx = " << _dx << std::endl;
 
-    for (const auto& coords: sds) {
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        size_t k_center = sds.convert(range.x, j);
+        for (int i = range.x; i < range.x + int(range.length); ++i, ++k_center) {
+            //std::cout << "i" << i << std::endl;
+            size_t k_bottom = sds.convert(i, j - 1);
+            size_t k_top = sds.convert(i, j + 1);
+            size_t k_bottom_center(k_bottom);
+            size_t k_top_center(k_top);
+            size_t k_bottom_bottom_center(k_bottom - 1);
+            size_t k_top_top_center(k_top + 1);
+            size_t k_left(k_center - 1);
+            size_t k_right(k_center + 1);
+            size_t k_left_center(k_center - 1);
+            size_t k_right_center(k_center + 1);
+            size_t k_left_left_center(k_center - 2);
+            size_t k_right_right_center(k_center + 2);
 
-        const int i = coords.first;
-        const int j = coords.second;
-        //std::cout << "i" << i << std::endl;
-        size_t k_center = sds.convert(i, j);
-        size_t k_bottom = sds.convert(i, j - 1);
-        size_t k_top = sds.convert(i, j + 1);
-        size_t k_bottom_center(k_bottom);
-        size_t k_top_center(k_top);
-        size_t k_bottom_bottom_center(k_bottom - 1);
-        size_t k_top_top_center(k_top + 1);
-        size_t k_left(k_center - 1);
-        size_t k_right(k_center + 1);
-        size_t k_left_center(k_center - 1);
-        size_t k_right_center(k_center + 1);
-        size_t k_left_left_center(k_center - 2);
-        size_t k_right_right_center(k_center + 2);
+            //std::cout << "kcenter" << k_center << std::endl;
+            //std::cout << "kright" << k_right << std::endl;
+            //std::cout << "kbottom" << k_bottom << std::endl;
 
-        //std::cout << "kcenter" << k_center << std::endl;
-        //std::cout << "kright" << k_right << std::endl;
-        //std::cout << "kbottom" << k_bottom << std::endl;
 
-        real rho_leftO1 = rho.get0(k_left);
-        real rho_rightO1 = rho.get0(k_right);
 
-        //std::cout << "rholeft O1 = " << rho_leftO1 << " rhoright O1 = " << rho_rightO1 << std::endl;
 
 
 
-
-
-        real rho_center = rho.get0(k_center);
+            real rho_center = rho[k_center];
         
-        real rho_left_center = rho.get0(k_left_center);
-        real rho_right_center = rho.get0(k_right_center);
-        real rho_left_left_center = rho.get0(k_left_left_center);
-        real rho_right_right_center = rho.get0(k_right_right_center);
-
-        real rho_bottom_center = rho.get0(k_bottom_center);
-        real rho_top_center = rho.get0(k_top_center);
-        real rho_bottom_bottom_center = rho.get0(k_bottom_bottom_center);
-        real rho_top_top_center = rho.get0(k_top_top_center);
+            real rho_left_center = rho[k_left_center];
+            real rho_right_center = rho[k_right_center];
+            real rho_left_left_center = rho[k_left_left_center];
+            real rho_right_right_center = rho[k_right_right_center];
+
+            real rho_bottom_center = rho[k_bottom_center];
+            real rho_top_center = rho[k_top_center];
+            real rho_bottom_bottom_center = rho[k_bottom_bottom_center];
+            real rho_top_top_center = rho[k_top_top_center];
       
 
 
  
-        real rhou_x_center = rhou_x.get0(k_center);
+            real rhou_x_center = rhou_x[k_center];
         
-        real rhou_x_left_center = rhou_x.get0(k_left_center);
-        real rhou_x_right_center = rhou_x.get0(k_right_center);
-        real rhou_x_left_left_center = rhou_x.get0(k_left_left_center);
-        real rhou_x_right_right_center = rhou_x.get0(k_right_right_center);
+            real rhou_x_left_center = rhou_x[k_left_center];
+            real rhou_x_right_center = rhou_x[k_right_center];
+            real rhou_x_left_left_center = rhou_x[k_left_left_center];
+            real rhou_x_right_right_center = rhou_x[k_right_right_center];
 
-        real rhou_x_bottom_center = rhou_x.get0(k_bottom_center);
-        real rhou_x_top_center = rhou_x.get0(k_top_center);
-        real rhou_x_bottom_bottom_center = rhou_x.get0(k_bottom_bottom_center);
-        real rhou_x_top_top_center = rhou_x.get0(k_top_top_center);
+            real rhou_x_bottom_center = rhou_x[k_bottom_center];
+            real rhou_x_top_center = rhou_x[k_top_center];
+            real rhou_x_bottom_bottom_center = rhou_x[k_bottom_bottom_center];
+            real rhou_x_top_top_center = rhou_x[k_top_top_center];
 
 
-        real rhou_y_center = rhou_y.get0(k_center);
+            real rhou_y_center = rhou_y[k_center];
 
-        real rhou_y_left_center = rhou_y.get0(k_left_center);
-        real rhou_y_right_center = rhou_y.get0(k_right_center);
-        real rhou_y_left_left_center = rhou_y.get0(k_left_left_center);
-        real rhou_y_right_right_center = rhou_y.get0(k_right_right_center);
+            real rhou_y_left_center = rhou_y[k_left_center];
+            real rhou_y_right_center = rhou_y[k_right_center];
+            real rhou_y_left_left_center = rhou_y[k_left_left_center];
+            real rhou_y_right_right_center = rhou_y[k_right_right_center];
 
-        real rhou_y_bottom_center = rhou_y.get0(k_bottom_center);
-        real rhou_y_top_center = rhou_y.get0(k_top_center);
-        real rhou_y_bottom_bottom_center = rhou_y.get0(k_bottom_bottom_center);
-        real rhou_y_top_top_center = rhou_y.get0(k_top_top_center);
+            real rhou_y_bottom_center = rhou_y[k_bottom_center];
+            real rhou_y_top_center = rhou_y[k_top_center];
+            real rhou_y_bottom_bottom_center = rhou_y[k_bottom_bottom_center];
+            real rhou_y_top_top_center = rhou_y[k_top_top_center];
 
 
-        /*
-        if (rhou_y_center != 0. || rhou_y_left != 0. || rhou_y_right != 0.) {
-            std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
-            std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
-            std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
-            exitfail(1);
-        } */
+            /*
+            if (rhou_y_center != 0. || rhou_y_left != 0. || rhou_y_right != 0.) {
+                std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
+                std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
+                std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
+                std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
+                std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
+                exitfail(1);
+            } */
 
-        real rhoE_center = rhoE.get0(k_center);
+            real rhoE_center = rhoE[k_center];
         
-        real rhoE_left_center = rhoE.get0(k_left_center);
-        real rhoE_right_center = rhoE.get0(k_right_center);
-        real rhoE_left_left_center = rhoE.get0(k_left_left_center);
-        real rhoE_right_right_center = rhoE.get0(k_right_right_center);
+            real rhoE_left_center = rhoE[k_left_center];
+            real rhoE_right_center = rhoE[k_right_center];
+            real rhoE_left_left_center = rhoE[k_left_left_center];
+            real rhoE_right_right_center = rhoE[k_right_right_center];
             
-        real rhoE_bottom_center = rhoE.get0(k_bottom_center);
-        real rhoE_top_center = rhoE.get0(k_top_center);
-        real rhoE_bottom_bottom_center = rhoE.get0(k_bottom_bottom_center);
-        real rhoE_top_top_center = rhoE.get0(k_top_top_center);
+            real rhoE_bottom_center = rhoE[k_bottom_center];
+            real rhoE_top_center = rhoE[k_top_center];
+            real rhoE_bottom_bottom_center = rhoE[k_bottom_bottom_center];
+            real rhoE_top_top_center = rhoE[k_top_top_center];
 
 
-        real cell_sx_left = sx.get0(k_left);
-        real cell_sx_center = sx.get0(k_center);
-        real cell_sx_right = sx.get0(k_right);
+            real cell_sx_left = sx[k_left];
+            real cell_sx_center = sx[k_center];
+            real cell_sx_right = sx[k_right];
 
-        real cell_sy_top = sy.get0(k_top);
-        real cell_sy_center = sy.get0(k_center);
-        real cell_sy_bottom = sy.get0(k_bottom);
+            real cell_sy_top = sy[k_top];
+            real cell_sy_center = sy[k_center];
+            real cell_sy_bottom = sy[k_bottom];
 
-        real sx_left  = std::max(cell_sx_left, cell_sx_center);
-        real sx_right = std::max(cell_sx_right, cell_sx_center);
+            real sx_left  = std::max(cell_sx_left, cell_sx_center);
+            real sx_right = std::max(cell_sx_right, cell_sx_center);
 
-        real sy_top  = std::max(cell_sy_top, cell_sy_center);
-        real sy_bottom = std::max(cell_sy_bottom, cell_sy_center);
+            real sy_top  = std::max(cell_sy_top, cell_sy_center);
+            real sy_bottom = std::max(cell_sy_bottom, cell_sy_center);
 
 
-        // U = (rho, rhou_x, rhou_y, rhoE)
-        // F = (rhou_x, rhou_x * rhou_x / rho + P, rhou_x *rhou_y / rho, (rhoE + P) * rhou_x / rho)
-        // F^n_x = (1. / 2.) * ( F(U^n_{i + 1,j}) - F(U^n_{i - 1,j}) - a^n_{i+1/2,j} * (U^n_{i+1, j} - U^n_{i, j}) + a^n_{i-1/2,j} * (U^n_{i, j} - U^n_{i-1, j}))
+            // U = (rho, rhou_x, rhou_y, rhoE)
+            // F = (rhou_x, rhou_x * rhou_x / rho + P, rhou_x *rhou_y / rho, (rhoE + P) * rhou_x / rho)
+            // F^n_x = (1. / 2.) * ( F(U^n_{i + 1,j}) - F(U^n_{i - 1,j}) - a^n_{i+1/2,j} * (U^n_{i+1, j} - U^n_{i, j}) + a^n_{i-1/2,j} * (U^n_{i, j} - U^n_{i-1, j}))
 
-        // G = (rhou_y, rhou_x *rhou_y / rho, rhou_y * rhou_y / rho + P, (rhoE + P) * rhou_y / rho)
-        // G^n_y = (1. / 2.) * ( G(U^n_{i,j + 1}) - G(U^n_{i,j - 1}) - a^n_{i,j+1/2} * (U^n_{i, j+1} - U^n_{i, j}) + a^n_{i,j-1/2} * (U^n_{i, j} - U^n_{i, j-1}))
+            // G = (rhou_y, rhou_x *rhou_y / rho, rhou_y * rhou_y / rho + P, (rhoE + P) * rhou_y / rho)
+            // G^n_y = (1. / 2.) * ( G(U^n_{i,j + 1}) - G(U^n_{i,j - 1}) - a^n_{i,j+1/2} * (U^n_{i, j+1} - U^n_{i, j}) + a^n_{i,j-1/2} * (U^n_{i, j} - U^n_{i, j-1}))
 
 
 
 
 
 
-        real rho_sigma_left = (rho_center - rho_left_center)/(_dx);
-        real rho_sigma_right = (rho_right_center - rho_center)/(_dx);
-        real rho_sigma_left_left = (rho_left_center - rho_left_left_center)/(_dx);
-        real rho_sigma_right_right = (rho_right_right_center - rho_right_center)/(_dx);
-        real rho_by_x_slope_center = minmod(rho_sigma_left, rho_sigma_right);
-        real rho_slope_left = minmod(rho_sigma_left_left, rho_sigma_left);
-        real rho_slope_right = minmod(rho_sigma_right, rho_sigma_right_right);
+            real rho_sigma_left = (rho_center - rho_left_center)/(_dx);
+            real rho_sigma_right = (rho_right_center - rho_center)/(_dx);
+            real rho_sigma_left_left = (rho_left_center - rho_left_left_center)/(_dx);
+            real rho_sigma_right_right = (rho_right_right_center - rho_right_center)/(_dx);
+            real rho_by_x_slope_center = minmod(rho_sigma_left, rho_sigma_right);
+            real rho_slope_left = minmod(rho_sigma_left_left, rho_sigma_left);
+            real rho_slope_right = minmod(rho_sigma_right, rho_sigma_right_right);
 
-        real rho_left_moins = rho_left_center + rho_slope_left * _dx * Number::half;
-        real rho_left_plus = rho_center - rho_by_x_slope_center * _dx * Number::half;
-        real rho_right_moins = rho_center + rho_by_x_slope_center*_dx * Number::half;
-        real rho_right_plus = rho_right_center - rho_slope_right*_dx * Number::half;
-        real rho_left = (rho_left_moins + rho_left_plus) * Number::half;
-        real rho_right = (rho_right_moins + rho_right_plus) * Number::half;
+            real rho_left_moins = rho_left_center + rho_slope_left * _dx * Number::half;
+            real rho_left_plus = rho_center - rho_by_x_slope_center * _dx * Number::half;
+            real rho_right_moins = rho_center + rho_by_x_slope_center*_dx * Number::half;
+            real rho_right_plus = rho_right_center - rho_slope_right*_dx * Number::half;
+            real rho_left = (rho_left_moins + rho_left_plus) * Number::half;
+            real rho_right = (rho_right_moins + rho_right_plus) * Number::half;
 
-     //   rho_left = rho_left_moins;
-     //   rho_right = rho_right_plus;
+         //   rho_left = rho_left_moins;
+         //   rho_right = rho_right_plus;
 
 
-        real rho_sigma_bottom = (rho_center - rho_bottom_center)/(_dx);
-        real rho_sigma_top = (rho_top_center - rho_center)/(_dx);
-        real rho_sigma_bottom_bottom = (rho_bottom_center - rho_bottom_bottom_center)/(_dx);
-        real rho_sigma_top_top = (rho_top_top_center - rho_top_center)/(_dx);
-        real rho_by_y_slope_center = minmod(rho_sigma_bottom, rho_sigma_top);
-        real rho_slope_bottom = minmod(rho_sigma_bottom_bottom, rho_sigma_bottom);
-        real rho_slope_top = minmod(rho_sigma_top, rho_sigma_top_top);
+            real rho_sigma_bottom = (rho_center - rho_bottom_center)/(_dx);
+            real rho_sigma_top = (rho_top_center - rho_center)/(_dx);
+            real rho_sigma_bottom_bottom = (rho_bottom_center - rho_bottom_bottom_center)/(_dx);
+            real rho_sigma_top_top = (rho_top_top_center - rho_top_center)/(_dx);
+            real rho_by_y_slope_center = minmod(rho_sigma_bottom, rho_sigma_top);
+            real rho_slope_bottom = minmod(rho_sigma_bottom_bottom, rho_sigma_bottom);
+            real rho_slope_top = minmod(rho_sigma_top, rho_sigma_top_top);
 
-        real rho_bottom_moins = rho_bottom_center + rho_slope_bottom * _dx * Number::half;
-        real rho_bottom_plus = rho_center - rho_by_y_slope_center * _dx * Number::half;
-        real rho_top_moins = rho_center + rho_by_y_slope_center*_dx * Number::half;
-        real rho_top_plus = rho_top_center - rho_slope_top*_dx * Number::half;
-        real rho_bottom = (rho_bottom_moins + rho_bottom_plus) * Number::half;
-        real rho_top = (rho_top_moins + rho_top_plus) * Number::half;
+            real rho_bottom_moins = rho_bottom_center + rho_slope_bottom * _dx * Number::half;
+            real rho_bottom_plus = rho_center - rho_by_y_slope_center * _dx * Number::half;
+            real rho_top_moins = rho_center + rho_by_y_slope_center*_dx * Number::half;
+            real rho_top_plus = rho_top_center - rho_slope_top*_dx * Number::half;
+            real rho_bottom = (rho_bottom_moins + rho_bottom_plus) * Number::half;
+            real rho_top = (rho_top_moins + rho_top_plus) * Number::half;
 
-     //   rho_bottom = rho_bottom_moins;
-     //   rho_top = rho_top_plus;
+         //   rho_bottom = rho_bottom_moins;
+         //   rho_top = rho_top_plus;
 
 
  
 
-        real rhou_x_sigma_left = (rhou_x_center - rhou_x_left_center)/(_dx);
-        real rhou_x_sigma_right = (rhou_x_right_center - rhou_x_center)/(_dx);
-        real rhou_x_sigma_left_left = (rhou_x_left_center - rhou_x_left_left_center)/(_dx);
-        real rhou_x_sigma_right_right = (rhou_x_right_right_center - rhou_x_right_center)/(_dx);
-        real rhou_x_by_x_slope_center = minmod(rhou_x_sigma_left, rhou_x_sigma_right);
-        real rhou_x_slope_left = minmod(rhou_x_sigma_left_left, rhou_x_sigma_left);
-        real rhou_x_slope_right = minmod(rhou_x_sigma_right, rhou_x_sigma_right_right);
+            real rhou_x_sigma_left = (rhou_x_center - rhou_x_left_center)/(_dx);
+            real rhou_x_sigma_right = (rhou_x_right_center - rhou_x_center)/(_dx);
+            real rhou_x_sigma_left_left = (rhou_x_left_center - rhou_x_left_left_center)/(_dx);
+            real rhou_x_sigma_right_right = (rhou_x_right_right_center - rhou_x_right_center)/(_dx);
+            real rhou_x_by_x_slope_center = minmod(rhou_x_sigma_left, rhou_x_sigma_right);
+            real rhou_x_slope_left = minmod(rhou_x_sigma_left_left, rhou_x_sigma_left);
+            real rhou_x_slope_right = minmod(rhou_x_sigma_right, rhou_x_sigma_right_right);
         
-        real rhou_x_left_moins = rhou_x_left_center + rhou_x_slope_left * _dx * Number::half;
-        real rhou_x_left_plus = rhou_x_center - rhou_x_by_x_slope_center * _dx * Number::half;
-        real rhou_x_right_moins = rhou_x_center + rhou_x_by_x_slope_center*_dx * Number::half; 
-        real rhou_x_right_plus = rhou_x_right_center - rhou_x_slope_right*_dx * Number::half;
-        real rhou_x_left = (rhou_x_left_moins + rhou_x_left_plus) * Number::half;
-        real rhou_x_right = (rhou_x_right_moins + rhou_x_right_plus) * Number::half;
-
-
-       // rhou_x_left = rhou_x_left_moins;
-      //  rhou_x_right = rhou_x_right_plus;
-
-        real rhou_x_sigma_bottom = (rhou_x_center - rhou_x_bottom_center)/(_dx);
-        real rhou_x_sigma_top = (rhou_x_top_center - rhou_x_center)/(_dx);
-        real rhou_x_sigma_bottom_bottom = (rhou_x_bottom_center - rhou_x_bottom_bottom_center)/(_dx);
-        real rhou_x_sigma_top_top = (rhou_x_top_top_center - rhou_x_top_center)/(_dx);
-        real rhou_x_by_y_slope_center = minmod(rhou_x_sigma_bottom, rhou_x_sigma_top);
-        real rhou_x_slope_bottom = minmod(rhou_x_sigma_bottom_bottom, rhou_x_sigma_bottom);
-        real rhou_x_slope_top = minmod(rhou_x_sigma_top, rhou_x_sigma_top_top);
+            real rhou_x_left_moins = rhou_x_left_center + rhou_x_slope_left * _dx * Number::half;
+            real rhou_x_left_plus = rhou_x_center - rhou_x_by_x_slope_center * _dx * Number::half;
+            real rhou_x_right_moins = rhou_x_center + rhou_x_by_x_slope_center*_dx * Number::half; 
+            real rhou_x_right_plus = rhou_x_right_center - rhou_x_slope_right*_dx * Number::half;
+            real rhou_x_left = (rhou_x_left_moins + rhou_x_left_plus) * Number::half;
+            real rhou_x_right = (rhou_x_right_moins + rhou_x_right_plus) * Number::half;
+
+
+           // rhou_x_left = rhou_x_left_moins;
+          //  rhou_x_right = rhou_x_right_plus;
+
+            real rhou_x_sigma_bottom = (rhou_x_center - rhou_x_bottom_center)/(_dx);
+            real rhou_x_sigma_top = (rhou_x_top_center - rhou_x_center)/(_dx);
+            real rhou_x_sigma_bottom_bottom = (rhou_x_bottom_center - rhou_x_bottom_bottom_center)/(_dx);
+            real rhou_x_sigma_top_top = (rhou_x_top_top_center - rhou_x_top_center)/(_dx);
+            real rhou_x_by_y_slope_center = minmod(rhou_x_sigma_bottom, rhou_x_sigma_top);
+            real rhou_x_slope_bottom = minmod(rhou_x_sigma_bottom_bottom, rhou_x_sigma_bottom);
+            real rhou_x_slope_top = minmod(rhou_x_sigma_top, rhou_x_sigma_top_top);
         
-        real rhou_x_bottom_moins = rhou_x_bottom_center + rhou_x_slope_bottom * _dx * Number::half;
-        real rhou_x_bottom_plus = rhou_x_center - rhou_x_by_y_slope_center * _dx * Number::half;
-        real rhou_x_top_moins = rhou_x_center + rhou_x_by_y_slope_center*_dx * Number::half; 
-        real rhou_x_top_plus = rhou_x_top_center - rhou_x_slope_top*_dx * Number::half;
-        real rhou_x_bottom = (rhou_x_bottom_moins + rhou_x_bottom_plus) * Number::half;
-        real rhou_x_top = (rhou_x_top_moins + rhou_x_top_plus) * Number::half;
+            real rhou_x_bottom_moins = rhou_x_bottom_center + rhou_x_slope_bottom * _dx * Number::half;
+            real rhou_x_bottom_plus = rhou_x_center - rhou_x_by_y_slope_center * _dx * Number::half;
+            real rhou_x_top_moins = rhou_x_center + rhou_x_by_y_slope_center*_dx * Number::half; 
+            real rhou_x_top_plus = rhou_x_top_center - rhou_x_slope_top*_dx * Number::half;
+            real rhou_x_bottom = (rhou_x_bottom_moins + rhou_x_bottom_plus) * Number::half;
+            real rhou_x_top = (rhou_x_top_moins + rhou_x_top_plus) * Number::half;
 
-     //   rhou_x_bottom = rhou_x_bottom_moins;
-     //   rhou_x_top = rhou_x_top_plus;
+         //   rhou_x_bottom = rhou_x_bottom_moins;
+         //   rhou_x_top = rhou_x_top_plus;
 
 
 
  
-        real rhou_y_sigma_left = (rhou_y_center - rhou_y_left_center)/(_dx);
-        real rhou_y_sigma_right = (rhou_y_right_center - rhou_y_center)/(_dx);
-        real rhou_y_sigma_left_left = (rhou_y_left_center - rhou_y_left_left_center)/(_dx);
-        real rhou_y_sigma_right_right = (rhou_y_right_right_center - rhou_y_right_center)/(_dx);
-        real rhou_y_by_x_slope_center = minmod(rhou_y_sigma_left, rhou_y_sigma_right);
-        real rhou_y_slope_left = minmod(rhou_y_sigma_left_left, rhou_y_sigma_left);
-        real rhou_y_slope_right = minmod(rhou_y_sigma_right, rhou_y_sigma_right_right);
+            real rhou_y_sigma_left = (rhou_y_center - rhou_y_left_center)/(_dx);
+            real rhou_y_sigma_right = (rhou_y_right_center - rhou_y_center)/(_dx);
+            real rhou_y_sigma_left_left = (rhou_y_left_center - rhou_y_left_left_center)/(_dx);
+            real rhou_y_sigma_right_right = (rhou_y_right_right_center - rhou_y_right_center)/(_dx);
+            real rhou_y_by_x_slope_center = minmod(rhou_y_sigma_left, rhou_y_sigma_right);
+            real rhou_y_slope_left = minmod(rhou_y_sigma_left_left, rhou_y_sigma_left);
+            real rhou_y_slope_right = minmod(rhou_y_sigma_right, rhou_y_sigma_right_right);
        
-        real rhou_y_left_moins = rhou_y_left_center + rhou_y_slope_left * _dx * Number::half;
-        real rhou_y_left_plus = rhou_y_center - rhou_y_by_x_slope_center * _dx * Number::half;
-        real rhou_y_right_moins = rhou_y_center + rhou_y_by_x_slope_center*_dx * Number::half; 
-        real rhou_y_right_plus = rhou_y_right_center - rhou_y_slope_right*_dx * Number::half;
-        real rhou_y_left = (rhou_y_left_moins + rhou_y_left_plus) * Number::half;
-        real rhou_y_right = (rhou_y_right_moins + rhou_y_right_plus) * Number::half;
-
-     //   rhou_y_left = rhou_y_left_moins;
-     //   rhou_y_right = rhou_y_right_plus;
+            real rhou_y_left_moins = rhou_y_left_center + rhou_y_slope_left * _dx * Number::half;
+            real rhou_y_left_plus = rhou_y_center - rhou_y_by_x_slope_center * _dx * Number::half;
+            real rhou_y_right_moins = rhou_y_center + rhou_y_by_x_slope_center*_dx * Number::half; 
+            real rhou_y_right_plus = rhou_y_right_center - rhou_y_slope_right*_dx * Number::half;
+            real rhou_y_left = (rhou_y_left_moins + rhou_y_left_plus) * Number::half;
+            real rhou_y_right = (rhou_y_right_moins + rhou_y_right_plus) * Number::half;
+
+         //   rhou_y_left = rhou_y_left_moins;
+         //   rhou_y_right = rhou_y_right_plus;
         
 
-        real rhou_y_sigma_bottom = (rhou_y_center - rhou_y_bottom_center)/(_dx);
-        real rhou_y_sigma_top = (rhou_y_top_center - rhou_y_center)/(_dx);
-        real rhou_y_sigma_bottom_bottom = (rhou_y_bottom_center - rhou_y_bottom_bottom_center)/(_dx);
-        real rhou_y_sigma_top_top = (rhou_y_top_top_center - rhou_y_top_center)/(_dx);
-        real rhou_y_by_y_slope_center = minmod(rhou_y_sigma_bottom, rhou_y_sigma_top);
-        real rhou_y_slope_bottom = minmod(rhou_y_sigma_bottom_bottom, rhou_y_sigma_bottom);
-        real rhou_y_slope_top = minmod(rhou_y_sigma_top, rhou_y_sigma_top_top);
+            real rhou_y_sigma_bottom = (rhou_y_center - rhou_y_bottom_center)/(_dx);
+            real rhou_y_sigma_top = (rhou_y_top_center - rhou_y_center)/(_dx);
+            real rhou_y_sigma_bottom_bottom = (rhou_y_bottom_center - rhou_y_bottom_bottom_center)/(_dx);
+            real rhou_y_sigma_top_top = (rhou_y_top_top_center - rhou_y_top_center)/(_dx);
+            real rhou_y_by_y_slope_center = minmod(rhou_y_sigma_bottom, rhou_y_sigma_top);
+            real rhou_y_slope_bottom = minmod(rhou_y_sigma_bottom_bottom, rhou_y_sigma_bottom);
+            real rhou_y_slope_top = minmod(rhou_y_sigma_top, rhou_y_sigma_top_top);
         
-        real rhou_y_bottom_moins = rhou_y_bottom_center + rhou_y_slope_bottom * _dx * Number::half;
-        real rhou_y_bottom_plus = rhou_y_center - rhou_y_by_y_slope_center * _dx * Number::half;
-        real rhou_y_top_moins = rhou_y_center + rhou_y_by_y_slope_center*_dx * Number::half; 
-        real rhou_y_top_plus = rhou_y_top_center - rhou_y_slope_top*_dx * Number::half;
-        real rhou_y_bottom = (rhou_y_bottom_moins + rhou_y_bottom_plus) * Number::half;
-        real rhou_y_top = (rhou_y_top_moins + rhou_y_top_plus) * Number::half;
+            real rhou_y_bottom_moins = rhou_y_bottom_center + rhou_y_slope_bottom * _dx * Number::half;
+            real rhou_y_bottom_plus = rhou_y_center - rhou_y_by_y_slope_center * _dx * Number::half;
+            real rhou_y_top_moins = rhou_y_center + rhou_y_by_y_slope_center*_dx * Number::half; 
+            real rhou_y_top_plus = rhou_y_top_center - rhou_y_slope_top*_dx * Number::half;
+            real rhou_y_bottom = (rhou_y_bottom_moins + rhou_y_bottom_plus) * Number::half;
+            real rhou_y_top = (rhou_y_top_moins + rhou_y_top_plus) * Number::half;
 
-     //   rhou_y_bottom = rhou_y_bottom_moins;
-    //    rhou_y_top = rhou_y_top_plus;
+         //   rhou_y_bottom = rhou_y_bottom_moins;
+        //    rhou_y_top = rhou_y_top_plus;
 
 
 
 
-        real rhoE_sigma_left = (rhoE_center - rhoE_left_center)/(_dx);
-        real rhoE_sigma_right = (rhoE_right_center - rhoE_center)/(_dx);
-        real rhoE_sigma_left_left = (rhoE_left_center - rhoE_left_left_center)/(_dx);
-        real rhoE_sigma_right_right = (rhoE_right_right_center - rhoE_right_center)/(_dx);
-        real rhoE_by_x_slope_center = minmod(rhoE_sigma_left, rhoE_sigma_right);
-        real rhoE_slope_left = minmod(rhoE_sigma_left_left, rhoE_sigma_left);
-        real rhoE_slope_right = minmod(rhoE_sigma_right, rhoE_sigma_right_right);
+            real rhoE_sigma_left = (rhoE_center - rhoE_left_center)/(_dx);
+            real rhoE_sigma_right = (rhoE_right_center - rhoE_center)/(_dx);
+            real rhoE_sigma_left_left = (rhoE_left_center - rhoE_left_left_center)/(_dx);
+            real rhoE_sigma_right_right = (rhoE_right_right_center - rhoE_right_center)/(_dx);
+            real rhoE_by_x_slope_center = minmod(rhoE_sigma_left, rhoE_sigma_right);
+            real rhoE_slope_left = minmod(rhoE_sigma_left_left, rhoE_sigma_left);
+            real rhoE_slope_right = minmod(rhoE_sigma_right, rhoE_sigma_right_right);
        
-        real rhoE_left_moins = rhoE_left_center + rhoE_slope_left * _dx * Number::half;
-        real rhoE_left_plus = rhoE_center - rhoE_by_x_slope_center * _dx * Number::half;
-        real rhoE_right_moins = rhoE_center + rhoE_by_x_slope_center*_dx * Number::half; 
-        real rhoE_right_plus = rhoE_right_center - rhoE_slope_right*_dx * Number::half;
-        real rhoE_left = (rhoE_left_moins + rhoE_left_plus) * Number::half;
-        real rhoE_right = (rhoE_right_moins + rhoE_right_plus) * Number::half;
-
-   //     rhoE_left = rhoE_left_moins;
-   //     rhoE_right = rhoE_right_plus;
-
-
-        real rhoE_sigma_bottom = (rhoE_center - rhoE_bottom_center)/(_dx);
-        real rhoE_sigma_top = (rhoE_top_center - rhoE_center)/(_dx);
-        real rhoE_sigma_bottom_bottom = (rhoE_bottom_center - rhoE_bottom_bottom_center)/(_dx);
-        real rhoE_sigma_top_top = (rhoE_top_top_center - rhoE_top_center)/(_dx);
-        real rhoE_by_y_slope_center = minmod(rhoE_sigma_bottom, rhoE_sigma_top);
-        real rhoE_slope_bottom = minmod(rhoE_sigma_bottom_bottom, rhoE_sigma_bottom);
-        real rhoE_slope_top = minmod(rhoE_sigma_top, rhoE_sigma_top_top);
+            real rhoE_left_moins = rhoE_left_center + rhoE_slope_left * _dx * Number::half;
+            real rhoE_left_plus = rhoE_center - rhoE_by_x_slope_center * _dx * Number::half;
+            real rhoE_right_moins = rhoE_center + rhoE_by_x_slope_center*_dx * Number::half; 
+            real rhoE_right_plus = rhoE_right_center - rhoE_slope_right*_dx * Number::half;
+            real rhoE_left = (rhoE_left_moins + rhoE_left_plus) * Number::half;
+            real rhoE_right = (rhoE_right_moins + rhoE_right_plus) * Number::half;
+
+       //     rhoE_left = rhoE_left_moins;
+       //     rhoE_right = rhoE_right_plus;
+
+
+            real rhoE_sigma_bottom = (rhoE_center - rhoE_bottom_center)/(_dx);
+            real rhoE_sigma_top = (rhoE_top_center - rhoE_center)/(_dx);
+            real rhoE_sigma_bottom_bottom = (rhoE_bottom_center - rhoE_bottom_bottom_center)/(_dx);
+            real rhoE_sigma_top_top = (rhoE_top_top_center - rhoE_top_center)/(_dx);
+            real rhoE_by_y_slope_center = minmod(rhoE_sigma_bottom, rhoE_sigma_top);
+            real rhoE_slope_bottom = minmod(rhoE_sigma_bottom_bottom, rhoE_sigma_bottom);
+            real rhoE_slope_top = minmod(rhoE_sigma_top, rhoE_sigma_top_top);
         
-        real rhoE_bottom_moins = rhoE_bottom_center + rhoE_slope_bottom * _dx * Number::half;
-        real rhoE_bottom_plus = rhoE_center - rhoE_by_y_slope_center * _dx * Number::half;
-        real rhoE_top_moins = rhoE_center + rhoE_by_y_slope_center*_dx * Number::half; 
-        real rhoE_top_plus = rhoE_top_center - rhoE_slope_top*_dx * Number::half;
-        real rhoE_bottom = (rhoE_bottom_moins + rhoE_bottom_plus) * Number::half;
-        real rhoE_top = (rhoE_top_moins + rhoE_top_plus) * Number::half;
-
-  //      rhoE_bottom = rhoE_bottom_moins;
-  //      rhoE_top = rhoE_top_plus;
-
-
-/*
-
-         rho_left = rho.get0(k_left);
-         rho_center = rho.get0(k_center);
-         rho_right = rho.get0(k_right);
-         rho_top = rho.get0(k_top);
-         rho_bottom = rho.get0(k_bottom);
-
-         rhou_x_left = rhou_x.get0(k_left);
-         rhou_x_center = rhou_x.get0(k_center);
-         rhou_x_right = rhou_x.get0(k_right);
-         rhou_x_top = rhou_x.get0(k_top);
-         rhou_x_bottom = rhou_x.get0(k_bottom);
-
-         rhou_y_left = rhou_y.get0(k_left);
-         rhou_y_center = rhou_y.get0(k_center);
-         rhou_y_right = rhou_y.get0(k_right);
-         rhou_y_top = rhou_y.get0(k_top);
-         rhou_y_bottom = rhou_y.get0(k_bottom);
-
+            real rhoE_bottom_moins = rhoE_bottom_center + rhoE_slope_bottom * _dx * Number::half;
+            real rhoE_bottom_plus = rhoE_center - rhoE_by_y_slope_center * _dx * Number::half;
+            real rhoE_top_moins = rhoE_center + rhoE_by_y_slope_center*_dx * Number::half; 
+            real rhoE_top_plus = rhoE_top_center - rhoE_slope_top*_dx * Number::half;
+            real rhoE_bottom = (rhoE_bottom_moins + rhoE_bottom_plus) * Number::half;
+            real rhoE_top = (rhoE_top_moins + rhoE_top_plus) * Number::half;
 
-         rhoE_left = rhoE.get0(k_left);
-         rhoE_center = rhoE.get0(k_center);
-         rhoE_right = rhoE.get0(k_right);
-         rhoE_top = rhoE.get0(k_top);
-         rhoE_bottom = rhoE.get0(k_bottom);
+      //      rhoE_bottom = rhoE_bottom_moins;
+      //      rhoE_top = rhoE_top_plus;
 
 
-         rho_left = (rho.get0(k_left)+rho.get0(k_center)) * Number::half;
-         rho_center = rho.get0(k_center);
-         rho_right = (rho.get0(k_right)+rho.get0(k_center)) * Number::half;
-         rho_top = (rho.get0(k_top)+rho.get0(k_center)) * Number::half;
-         rho_bottom = (rho.get0(k_bottom)+rho.get0(k_center)) * Number::half;
+    /*
 
+             rho_left = rho[k_left];
+             rho_center = rho[k_center];
+             rho_right = rho[k_right];
+             rho_top = rho[k_top];
+             rho_bottom = rho[k_bottom];
+
+             rhou_x_left = rhou_x[k_left];
+             rhou_x_center = rhou_x[k_center];
+             rhou_x_right = rhou_x[k_right];
+             rhou_x_top = rhou_x[k_top];
+             rhou_x_bottom = rhou_x[k_bottom];
+
+             rhou_y_left = rhou_y[k_left];
+             rhou_y_center = rhou_y[k_center];
+             rhou_y_right = rhou_y[k_right];
+             rhou_y_top = rhou_y[k_top];
+             rhou_y_bottom = rhou_y[k_bottom];
+
+
+             rhoE_left = rhoE[k_left];
+             rhoE_center = rhoE[k_center];
+             rhoE_right = rhoE[k_right];
+             rhoE_top = rhoE[k_top];
+             rhoE_bottom = rhoE[k_bottom];
+
+
+             rho_left = (rho[k_left]+rho[k_center]) * Number::half;
+             rho_center = rho[k_center];
+             rho_right = (rho[k_right]+rho[k_center]) * Number::half;
+             rho_top = (rho[k_top]+rho[k_center]) * Number::half;
+             rho_bottom = (rho[k_bottom]+rho[k_center]) * Number::half;
+
+
+             rhou_x_left = (rhou_x[k_left]+rhou_x[k_center]) * Number::half;
+             rhou_x_center = rhou_x[k_center];
+             rhou_x_right = (rhou_x[k_right]+rhou_x[k_center]) * Number::half;
+             rhou_x_top = (rhou_x[k_top]+rhou_x[k_center]) * Number::half;
+             rhou_x_bottom = (rhou_x[k_bottom]+rhou_x[k_center]) * Number::half;
+
+             rhou_y_left = (rhou_y[k_left]+rhou_y[k_center]) * Number::half;
+             rhou_y_center = rhou_y[k_center];
+             rhou_y_right = (rhou_y[k_right]+rhou_y[k_center]) * Number::half;
+             rhou_y_top = (rhou_y[k_top]+rhou_y[k_center]) * Number::half;
+             rhou_y_bottom = (rhou_y[k_bottom]+rhou_y[k_center]) * Number::half;
+
+             rhoE_left = (rhoE[k_left]+rhoE[k_center]) * Number::half;
+             rhoE_center = rhoE[k_center];
+             rhoE_right = (rhoE[k_right]+rhoE[k_center]) * Number::half;
+             rhoE_top = (rhoE[k_top]+rhoE[k_center]) * Number::half;
+             rhoE_bottom = (rhoE[k_bottom]+rhoE[k_center]) * Number::half;
 
-         rhou_x_left = (rhou_x.get0(k_left)+rhou_x.get0(k_center)) * Number::half;
-         rhou_x_center = rhou_x.get0(k_center);
-         rhou_x_right = (rhou_x.get0(k_right)+rhou_x.get0(k_center)) * Number::half;
-         rhou_x_top = (rhou_x.get0(k_top)+rhou_x.get0(k_center)) * Number::half;
-         rhou_x_bottom = (rhou_x.get0(k_bottom)+rhou_x.get0(k_center)) * Number::half;
+    */
 
-         rhou_y_left = (rhou_y.get0(k_left)+rhou_y.get0(k_center)) * Number::half;
-         rhou_y_center = rhou_y.get0(k_center);
-         rhou_y_right = (rhou_y.get0(k_right)+rhou_y.get0(k_center)) * Number::half;
-         rhou_y_top = (rhou_y.get0(k_top)+rhou_y.get0(k_center)) * Number::half;
-         rhou_y_bottom = (rhou_y.get0(k_bottom)+rhou_y.get0(k_center)) * Number::half;
 
-         rhoE_left = (rhoE.get0(k_left)+rhoE.get0(k_center)) * Number::half;
-         rhoE_center = rhoE.get0(k_center);
-         rhoE_right = (rhoE.get0(k_right)+rhoE.get0(k_center)) * Number::half;
-         rhoE_top = (rhoE.get0(k_top)+rhoE.get0(k_center)) * Number::half;
-         rhoE_bottom = (rhoE.get0(k_bottom)+rhoE.get0(k_center)) * Number::half;
+            real ux_left = ((2 * rho_left - rho_center) == Number::zero) ? Number::zero : (2 * rhou_x_left - rhou_x_center) / (2 * rho_left - rho_center);
+            real ux_right = ((2 * rho_right - rho_center) == Number::zero) ? Number::zero : (2 * rhou_x_right - rhou_x_center) / (2 * rho_right - rho_center);
 
-*/
+            real uy_top = ((2 * rho_top - rho_center) == Number::zero) ? Number::zero : (2 * rhou_y_top - rhou_y_center) / (2 * rho_top - rho_center);
+            real uy_bottom = ((2 * rho_bottom - rho_center) == Number::zero) ? Number::zero : (2 * rhou_y_bottom - rhou_y_center) / (2 * rho_bottom - rho_center); 
 
+            real pressure_left = pressure[k_left];
+            real pressure_right = pressure[k_right];
+            real pressure_top = pressure[k_top];
+            real pressure_bottom = pressure[k_bottom];
 
-        real ux_left = ((2 * rho_left - rho_center) == Number::zero) ? Number::zero : (2 * rhou_x_left - rhou_x_center) / (2 * rho_left - rho_center);
-        real ux_right = ((2 * rho_right - rho_center) == Number::zero) ? Number::zero : (2 * rhou_x_right - rhou_x_center) / (2 * rho_right - rho_center);
+            real pressure_center = pressure[k_center];
 
-        real ux_center = (rho_center == Number::zero) ? Number::zero : rhou_x_center / rho_center;
-        real uy_center = (rho_center == Number::zero) ? Number::zero : rhou_y_center / rho_center;
-        
-        real uy_top = ((2 * rho_top - rho_center) == Number::zero) ? Number::zero : (2 * rhou_y_top - rhou_y_center) / (2 * rho_top - rho_center);
-        real uy_bottom = ((2 * rho_bottom - rho_center) == Number::zero) ? Number::zero : (2 * rhou_y_bottom - rhou_y_center) / (2 * rho_bottom - rho_center); 
+            pressure_left = (pressure[k_left]+pressure[k_center]) * Number::half;
+            pressure_right = (pressure[k_right]+pressure[k_center]) * Number::half;
+            pressure_center = pressure[k_center];
+            pressure_top = (pressure[k_top]+pressure[k_center]) * Number::half;
+            pressure_bottom = (pressure[k_bottom]+pressure[k_center]) * Number::half;
+  
 
-        real pressure_left = pressure.get0(k_left);
-        real pressure_right = pressure.get0(k_right);
-        real pressure_top = pressure.get0(k_top);
-        real pressure_bottom = pressure.get0(k_bottom);
 
-        real pressure_center = pressure.get0(k_center);
+            /*std::cout << "rholeft O2 = " << rho_left << " rhoright O2 = " << rho_right << std::endl;
+            std::cout << "= " << rho_left_center << " rhoslopeleft = " << rho_slope_left << std::endl;
+            std::cout << "rholeftmoins = " << rho_left_moins << " rholeftplus = " << rho_left_plus << std::endl;
+            std::cout << "rholeft O2 = " << rho_left << " rhoright O2 = " << rho_right << std::endl;
+            */
 
-        pressure_left = (pressure.get0(k_left)+pressure.get0(k_center)) * Number::half;
-        pressure_right = (pressure.get0(k_right)+pressure.get0(k_center)) * Number::half;
-        pressure_center = pressure.get0(k_center);
-        pressure_top = (pressure.get0(k_top)+pressure.get0(k_center)) * Number::half;
-        pressure_bottom = (pressure.get0(k_bottom)+pressure.get0(k_center)) * Number::half;
-  
+    /*
+            // Horizontal Flux
+            real rho_flux_x = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
 
+            real rhou_x_flux_x = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
 
-        /*std::cout << "rholeft O2 = " << rho_left << " rhoright O2 = " << rho_right << std::endl;
-        std::cout << "= " << rho_left_center << " rhoslopeleft = " << rho_slope_left << std::endl;
-        std::cout << "rholeftmoins = " << rho_left_moins << " rholeftplus = " << rho_left_plus << std::endl;
-        std::cout << "rholeft O2 = " << rho_left << " rhoright O2 = " << rho_right << std::endl;
-        */
+            real rhou_y_flux_x = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
 
-/*
-        // Horizontal Flux
-        real rho_flux_x = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
+            real rhoE_flux_x = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
 
-        real rhou_x_flux_x = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
+            // Vertical flux
+            real rho_flux_y = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
 
-        real rhou_y_flux_x = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
+            real rhou_x_flux_y = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
 
-        real rhoE_flux_x = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
+            real rhou_y_flux_y = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
 
-        // Vertical flux
-        real rho_flux_y = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
+            real rhoE_flux_y = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
+    */
 
-        real rhou_x_flux_y = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
+            const real kx = _dt / _dx;
+            const real ky = _dt / _dy;
 
-        real rhou_y_flux_y = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
+            // Horizontal Flux
+            real rho_flux_x = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
 
-        real rhoE_flux_y = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
-*/
+            real rhou_x_flux_x = (2 * rhou_x_right - rhou_x_center) * (ux_right * Number::half) + pressure_right - (2 * rhou_x_left - rhou_x_center) * (ux_left * Number::half) - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
 
-        const real kx = _dt / _dx;
-        const real ky = _dt / _dy;
+            real rhou_y_flux_x = (2 * rhou_y_right - rhou_y_center) * (ux_right * Number::half) - (2 * rhou_y_left - rhou_y_center) * (ux_left * Number::half) - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
 
-        // Horizontal Flux
-        real rho_flux_x = rhou_x_right - rhou_x_left - sx_right * (rho_right - rho_center) + sx_left * (rho_center - rho_left);
+            real rhoE_flux_x = ((2 * rhoE_right - rhoE_center) + (2 * pressure_right - pressure_center)) * (ux_right * Number::half) - ((2 * rhoE_left - rhoE_center) + (2 * pressure_left - pressure_center)) * (ux_left * Number::half) - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
 
-        real rhou_x_flux_x = (2 * rhou_x_right - rhou_x_center) * (ux_right * Number::half) + pressure_right - (2 * rhou_x_left - rhou_x_center) * (ux_left * Number::half) - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
+    /*
+            rhou_x_flux_x = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
 
-        real rhou_y_flux_x = (2 * rhou_y_right - rhou_y_center) * (ux_right * Number::half) - (2 * rhou_y_left - rhou_y_center) * (ux_left * Number::half) - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
+            rhou_y_flux_x = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
 
-        real rhoE_flux_x = ((2 * rhoE_right - rhoE_center) + (2 * pressure_right - pressure_center)) * (ux_right * Number::half) - ((2 * rhoE_left - rhoE_center) + (2 * pressure_left - pressure_center)) * (ux_left * Number::half) - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
+            rhoE_flux_x = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
+    */
 
-/*
-        rhou_x_flux_x = ux_right * rhou_x_right + pressure_right - ux_left * rhou_x_left  - pressure_left - sx_right * (rhou_x_right - rhou_x_center) + sx_left * (rhou_x_center - rhou_x_left);
 
-        rhou_y_flux_x = ux_right * rhou_y_right - ux_left * rhou_y_left - sx_right * (rhou_y_right - rhou_y_center) + sx_left * (rhou_y_center - rhou_y_left);
+            // Vertical flux
+            real rho_flux_y = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
 
-        rhoE_flux_x = (rhoE_right + pressure_right ) * ux_right - (rhoE_left + pressure_left ) * ux_left - sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left);
-*/
+            real rhou_x_flux_y = (2 * rhou_x_top - rhou_x_center) * (uy_top * Number::half) - (2 * rhou_x_bottom - rhou_x_center) * (uy_bottom * Number::half) - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
 
+            real rhou_y_flux_y = (2 * rhou_y_top - rhou_y_center) * (uy_top * Number::half) + pressure_top - (2 * rhou_y_bottom - rhou_y_center) * (uy_bottom * Number::half) - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
 
-        // Vertical flux
-        real rho_flux_y = rhou_y_top - rhou_y_bottom - sy_top * (rho_top - rho_center) + sy_bottom * (rho_center - rho_bottom);
+            real rhoE_flux_y = ((2 * rhoE_top - rhoE_center) + (2 * pressure_top - pressure_center)) * (uy_top * Number::half) - ((2 * rhoE_bottom - rhoE_center) + (2 * pressure_bottom - pressure_center)) * (uy_bottom * Number::half) - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
+        
+    /*
+            rhou_x_flux_y = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
 
-        real rhou_x_flux_y = (2 * rhou_x_top - rhou_x_center) * (uy_top * Number::half) - (2 * rhou_x_bottom - rhou_x_center) * (uy_bottom * Number::half) - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
+            rhou_y_flux_y = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
 
-        real rhou_y_flux_y = (2 * rhou_y_top - rhou_y_center) * (uy_top * Number::half) + pressure_top - (2 * rhou_y_bottom - rhou_y_center) * (uy_bottom * Number::half) - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
+            rhoE_flux_y = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
+    */
 
-        real rhoE_flux_y = ((2 * rhoE_top - rhoE_center) + (2 * pressure_top - pressure_center)) * (uy_top * Number::half) - ((2 * rhoE_bottom - rhoE_center) + (2 * pressure_bottom - pressure_center)) * (uy_bottom * Number::half) - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
-        
-/*
-        rhou_x_flux_y = rhou_x_top * uy_top - rhou_x_bottom * uy_bottom - sy_top * (rhou_x_top - rhou_x_center) + sy_bottom * (rhou_x_center - rhou_x_bottom);
-
-        rhou_y_flux_y = uy_top * rhou_y_top + pressure_top - uy_bottom * rhou_y_bottom  - pressure_bottom - sy_top * (rhou_y_top - rhou_y_center) + sy_bottom * (rhou_y_center - rhou_y_bottom);
-
-        rhoE_flux_y = (rhoE_top + pressure_top ) * uy_top - (rhoE_bottom + pressure_bottom ) * uy_bottom - sy_top * (rhoE_top - rhoE_center) + sy_bottom * (rhoE_center - rhoE_bottom);
-*/
-
-
-        std::cout.precision(4);
-        std::cout << "kcenter = " << k_center << std::endl;
-        std::cout << "rholeft = " << rho_left << std::endl;
-        std::cout << "rho instant n = " << rho_center << std::endl;
-        std::cout << "rho instant n+1 = " << rho_center - kx * rho_flux_x - ky * rho_flux_y << std::endl;
-        std::cout << "rhoright = " << rho_right << std::endl;
-        std::cout << "uxleft = " << ux_left << std::endl;
-        std::cout << "uxright= " << ux_right << std::endl;
-        std::cout << "rhouxleft = " << rhou_x_left << std::endl;
-        std::cout << "rhoux n = " << rhou_x_center << std::endl;
-        std::cout << "rhoux n+1 = " << rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y << std::endl;
-        std::cout << "rhoux right" << rhou_x_right << std::endl;
-        std::cout << "rhouxflux = " << rhou_x_flux_x << std::endl;
-        std::cout << "ux = " << (rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y) / (rho_center - kx * rho_flux_x - ky * rho_flux_y) << std::endl;
-        std::cout << "energy = " << (rhoE_center - kx * rhoE_flux_x  - ky * rhoE_flux_y) / (rho_center - kx * rho_flux_x - ky * rho_flux_y) << std::endl;
-        std::cout << "fluxenergy gauche = " << ((2 * rhoE_left - rhoE_center) + (2 * pressure_left - pressure_center)) * ux_left << std::endl;
-        std::cout << "flucenergy droite = " << ((2 * rhoE_right - rhoE_center) + (2 * pressure_right - pressure_center)) * ux_right << std::endl;
-        std::cout << "flucenergy sx = " << sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left) << std::endl;
-        std::cout << "rhoEflux = " << rhoE_flux_x << std::endl;
-        std::cout << "pressure gauche = " << pressure_left << std::endl;
-        std::cout << "pressire center = " << pressure_center << std::endl;
-        std::cout << "pressure droite = " << pressure_right << std::endl;
-
-        if ( rho_center - kx * rho_flux_x - ky * rho_flux_y >1){ exitfail(1);}
-        // Set new values.
-        rho.set1(rho_center - kx * rho_flux_x - ky * rho_flux_y, k_center);
-        rhou_x.set1(rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y, k_center);
-        rhou_y.set1(rhou_y_center - kx * rhou_y_flux_x - ky * rhou_y_flux_y, k_center);
-        rhoE.set1(rhoE_center - kx * rhoE_flux_x  - ky * rhoE_flux_y, k_center);
-
-
-        if (rho.get1(k_center) < Number::zero) {
-            std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
-            std::cout << "ux_right: " <<  ux_right << ", rhou_y_right: " <<  rhou_y_right << " = " << ux_right * rhou_y_right  << std::endl;
-            std::cout << "ux_left: " <<  ux_left << ", rhou_y_left: " <<  rhou_y_left << " = " << ux_left * rhou_y_left  << std::endl;
-            std::cout << "sx_right: " <<  sx_right << ", (rhou_y_right - rhou_y_center): " <<  (rhou_y_right - rhou_y_center) << " = " << sx_right * (rhou_y_right - rhou_y_center)  << std::endl;
-            std::cout << "sx_left: " <<  sx_left << ", (rhou_y_center - rhou_y_left): " <<  (rhou_y_center - rhou_y_left) << " = " << sx_left * (rhou_y_center - rhou_y_left)  << std::endl;
-
-            std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
-
-            std::cout << "rhou_y_flux_x: " <<  rhou_y_flux_x << std::endl << std::endl;
-
-            std::cout << "uy_top: " <<  uy_top<< ", rhou_y_top: " <<  rhou_y_top << " = " << uy_top * rhou_y_top  << std::endl;
-            std::cout << "uy_bottom: " <<  uy_bottom << ", rhou_y_bottom: " <<  rhou_y_bottom << " = " << uy_bottom * rhou_y_bottom  << std::endl;
-            std::cout << "sy_top: " <<  sy_top << ", (rhou_y_top - rhou_y_center): " <<  (rhou_y_top - rhou_y_center) << " = " << sy_top * (rhou_y_top - rhou_y_center)  << std::endl;
-            std::cout << "sy_bottom: " <<  sy_bottom << ", (rhou_y_center - rhou_y_bottom): " <<  (rhou_y_center - rhou_y_bottom) << " = " << sy_bottom * (rhou_y_center - rhou_y_bottom) << std::endl;
-            std::cout << "pressure_top: " <<  pressure_top << std::endl;
-            std::cout << "pressure_bottom: " <<  pressure_bottom << std::endl;
-            std::cout << "rhou_y_top: " <<  rhou_y_top << std::endl;
-            std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
-            std::cout << "rhou_y_bottom: " <<  rhou_y_bottom << std::endl;
-            std::cout << "rhou_y_flux_y: " <<  rhou_y_flux_y << std::endl;
-
-            std::cout << "rho_center: " <<  rho_center << std::endl;
-            std::cout << "kx * rho_flux_x: " <<  kx * rho_flux_x << std::endl;
-            std::cout << "ky * rho_flux_y: " <<  ky * rho_flux_y << std::endl;
-            std::cout << "rho.get1(k_center): " <<  rho.get1(k_center) << std::endl;
-
-            std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
-            std::cout << sds.getNumberBoundaryCells() << std::endl;
-            exitfail(1);
-        }
 
-        /*
-        if (rhou_y_flux_y > 0.) {
-            std::cout << "y";
+            std::cout.precision(4);
+            std::cout << "kcenter = " << k_center << std::endl;
+            std::cout << "rholeft = " << rho_left << std::endl;
+            std::cout << "rho instant n = " << rho_center << std::endl;
+            std::cout << "rho instant n+1 = " << rho_center - kx * rho_flux_x - ky * rho_flux_y << std::endl;
+            std::cout << "rhoright = " << rho_right << std::endl;
+            std::cout << "uxleft = " << ux_left << std::endl;
+            std::cout << "uxright= " << ux_right << std::endl;
+            std::cout << "rhouxleft = " << rhou_x_left << std::endl;
+            std::cout << "rhoux n = " << rhou_x_center << std::endl;
+            std::cout << "rhoux n+1 = " << rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y << std::endl;
+            std::cout << "rhoux right" << rhou_x_right << std::endl;
+            std::cout << "rhouxflux = " << rhou_x_flux_x << std::endl;
+            std::cout << "ux = " << (rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y) / (rho_center - kx * rho_flux_x - ky * rho_flux_y) << std::endl;
+            std::cout << "energy = " << (rhoE_center - kx * rhoE_flux_x  - ky * rhoE_flux_y) / (rho_center - kx * rho_flux_x - ky * rho_flux_y) << std::endl;
+            std::cout << "fluxenergy gauche = " << ((2 * rhoE_left - rhoE_center) + (2 * pressure_left - pressure_center)) * ux_left << std::endl;
+            std::cout << "flucenergy droite = " << ((2 * rhoE_right - rhoE_center) + (2 * pressure_right - pressure_center)) * ux_right << std::endl;
+            std::cout << "flucenergy sx = " << sx_right * (rhoE_right - rhoE_center) + sx_left * (rhoE_center - rhoE_left) << std::endl;
+            std::cout << "rhoEflux = " << rhoE_flux_x << std::endl;
+            std::cout << "pressure gauche = " << pressure_left << std::endl;
+            std::cout << "pressire center = " << pressure_center << std::endl;
+            std::cout << "pressure droite = " << pressure_right << std::endl;
+
+            if ( rho_center - kx * rho_flux_x - ky * rho_flux_y >1){ exitfail(1);}
+            // Set new values.
+            rho_next[k_center] = rho_center - kx * rho_flux_x - ky * rho_flux_y;
+            rhou_x_next[k_center] = rhou_x_center - kx * rhou_x_flux_x - ky * rhou_x_flux_y;
+            rhou_y_next[k_center] = rhou_y_center - kx * rhou_y_flux_x - ky * rhou_y_flux_y;
+            rhoE_next[k_center] = rhoE_center - kx * rhoE_flux_x  - ky * rhoE_flux_y;
+
+
+            if (rho_next[k_center] < Number::zero) {
+                std::cout << std::scientific << std::setprecision(std::numeric_limits<real>::max_digits10);
+                std::cout << "ux_right: " <<  ux_right << ", rhou_y_right: " <<  rhou_y_right << " = " << ux_right * rhou_y_right  << std::endl;
+                std::cout << "ux_left: " <<  ux_left << ", rhou_y_left: " <<  rhou_y_left << " = " << ux_left * rhou_y_left  << std::endl;
+                std::cout << "sx_right: " <<  sx_right << ", (rhou_y_right - rhou_y_center): " <<  (rhou_y_right - rhou_y_center) << " = " << sx_right * (rhou_y_right - rhou_y_center)  << std::endl;
+                std::cout << "sx_left: " <<  sx_left << ", (rhou_y_center - rhou_y_left): " <<  (rhou_y_center - rhou_y_left) << " = " << sx_left * (rhou_y_center - rhou_y_left)  << std::endl;
+
+                std::cout << "rhou_y_left: " <<  rhou_y_left << std::endl;
+                std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
+                std::cout << "rhou_y_right: " <<  rhou_y_right << std::endl;
+
+                std::cout << "rhou_y_flux_x: " <<  rhou_y_flux_x << std::endl << std::endl;
+
+                std::cout << "uy_top: " <<  uy_top<< ", rhou_y_top: " <<  rhou_y_top << " = " << uy_top * rhou_y_top  << std::endl;
+                std::cout << "uy_bottom: " <<  uy_bottom << ", rhou_y_bottom: " <<  rhou_y_bottom << " = " << uy_bottom * rhou_y_bottom  << std::endl;
+                std::cout << "sy_top: " <<  sy_top << ", (rhou_y_top - rhou_y_center): " <<  (rhou_y_top - rhou_y_center) << " = " << sy_top * (rhou_y_top - rhou_y_center)  << std::endl;
+                std::cout << "sy_bottom: " <<  sy_bottom << ", (rhou_y_center - rhou_y_bottom): " <<  (rhou_y_center - rhou_y_bottom) << " = " << sy_bottom * (rhou_y_center - rhou_y_bottom) << std::endl;
+                std::cout << "pressure_top: " <<  pressure_top << std::endl;
+                std::cout << "pressure_bottom: " <<  pressure_bottom << std::endl;
+                std::cout << "rhou_y_top: " <<  rhou_y_top << std::endl;
+                std::cout << "rhou_y_center: " <<  rhou_y_center << std::endl;
+                std::cout << "rhou_y_bottom: " <<  rhou_y_bottom << std::endl;
+                std::cout << "rhou_y_flux_y: " <<  rhou_y_flux_y << std::endl;
+
+                std::cout << "rho_center: " <<  rho_center << std::endl;
+                std::cout << "kx * rho_flux_x: " <<  kx * rho_flux_x << std::endl;
+                std::cout << "ky * rho_flux_y: " <<  ky * rho_flux_y << std::endl;
+                std::cout << "rho_next[k_center]: " <<  rho_next[k_center] << std::endl;
+
+                std::cout << _nIterations << " - i: " <<  i << ", j:" << j << std::endl;
+                std::cout << sds.getNumberBoundaryCells() << std::endl;
+                exitfail(1);
+            }
+
+            if (Fused) {
+                real sx_new, sy_new;
+                cellSpeed(rho_next[k_center], rhou_x_next[k_center], rhou_y_next[k_center], rhoE_next[k_center],
+                        pressure_next[k_center], sx_new, sy_new);
+                sx_next[k_center] = sx_new;
+                sy_next[k_center] = sy_new;
+
+                if (sdsUxMax < sx_new)
+                    sdsUxMax = sx_new;
+
+                if (sdsUyMax < sy_new)
+                    sdsUyMax = sy_new;
+            }
+
+            /*
+            if (rhou_y_flux_y > 0.) {
+                std::cout << "y";
+            }
+
+            #ifndef NDEBUG
+            if (rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y < 0.) {
+                std::cout << "rhoE_center: " <<  rhoE_center << std::endl;
+                std::cout << "rhoE_flux_x: " <<  rhoE_flux_x << std::endl;
+                std::cout << "rhoE+1: " <<  rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y << std::endl;
+            }
+            #endif
+            */
         }
+    }
 
-        #ifndef NDEBUG
-        if (rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y < 0.) {
-            std::cout << "rhoE_center: " <<  rhoE_center << std::endl;
-            std::cout << "rhoE_flux_x: " <<  rhoE_flux_x << std::endl;
-            std::cout << "rhoE+1: " <<  rhoE_center - kx * rhoE_flux_x  + ky * rhoE_flux_y << std::endl;
-        }
-        #endif
-        */
+    if (Fused) {
+        _SDS_uxmax[sds.getId()] = sdsUxMax;
+        _SDS_uymax[sds.getId()] = sdsUyMax;
     }
 }
 
@@ -897,6 +1040,15 @@ void EulerRuO2::updatePressure(const SDShared& sds, const std::map< std::string,
     // As a max, it's not necessary to update.
     // sds.updateBoundaryCells(quantityMap.at("sx"));
     // sds.updateBoundaryCells(quantityMap.at("sy"));
+
+    // The pressure arrays are switched by the fused sweep.
+    if (_fusedSweep)
+        sds.copyTimeVaryingCells(quantityMap.at("pressure"));
+}
+
+void EulerRuO2::updateBoundaries(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap) {
+    updateBoundary(sds, quantityMap);
+    updatePressure(sds, quantityMap);
 }
 
 void EulerRuO2::writeState(std::string directory) {
@@ -48,8 +48,52 @@ class EulerRuO2: public Engine {
     real computeSoundSpeed(const real& rho, const real& P);
     void speed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
     void flux(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief speed and flux on the layout of the conserved quantities:
+     * Lanes is 1 for SoA, Quantity::aosoaLanes for AoSoA.
+     */
+    template<unsigned int Lanes> void speedKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+    template<unsigned int Lanes, bool Fused> void fluxKernel(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief Fused sweep: flux, then pressure and speed of the new values
+     * in the next arrays of pressure, sx and sy. Saves the speed sweep of
+     * the next iteration.
+     */
+    void fluxSpeed(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
+
+    /*!
+     * @brief pressure and wave speeds of a cell (zero in vacuum)
+     */
+    void cellSpeed(const real rho, const real rhou_x, const real rhou_y, const real rhoE,
+            real& pressure, real& sx, real& sy);
     void updateBoundary(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
     void updatePressure(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
+
+    /*!
+     * @brief updateBoundary and updatePressure in one sweep, when the
+     * pressure was computed by the fused sweep.
+     */
+    void updateBoundaries(const SDShared& sds, const std::map< std::string, Quantity<real>*>& quantityMap);
+
+    /*!
+     * true when the flux and the speed are computed in one sweep (exec
+     * option sweep=fused)
+     */
+    bool _fusedSweep;
+
+    /*!
+     * true when the interior SDSs are computed during the communication of
+     * the overlap cells (exec option halo=overlap)
+     */
+    bool _haloOverlap;
+
+    /*!
+     * true when dt is reduced and t broadcast after the reduction of the
+     * maxima (exec option dtReduction=agreed)
+     */
+    bool _agreedTimeStep;
     real minmod(real a, real b);
     /*!
      * @brief Initialize transport upwind scheme engine
@@ -38,8 +38,14 @@ int Hydro8x1::init() {
     IO::loadExecOptions(_initpath, *_domain);
     IO::loadSDDInfo(_initpath, *_domain);
 
+    // The stencils below find the left and right neighbours at +/-1.
+    if (_domain->getExecOption("cellOrder", CoordConverter::ROW_MAJOR) != CoordConverter::ROW_MAJOR)
+        exitfail("Hydro8x1 only works with the row-major cell order.");
+
     // Now that the subdomains info were loaded they can be built
-    _domain->buildSubDomainsMPI(8, 1);
+    _timerSetup.begin();
+    _domain->buildSubDomainsMPI(8, 1, 4);
+    _timerSetup.end();
 
     // Initial time
     _t = 0;
@@ -69,14 +75,13 @@ int Hydro8x1::init() {
     std::fill(_SDS_uymax.begin(), _SDS_uymax.end(), 0);
 
     for (const auto& sds: sdd.getSDS()) {
-        for (std::pair<int, int> coords: sds) {
-
-            int i = coords.first;
-            int j = coords.second;
-
-            if (rho.get(0, i, j) != 0.) {
-                _SDS_uxmax[sds.getId()] = std::max(_SDS_uxmax[sds.getId()], std::abs(rhou_x.get(1, i, j) / rho.get(0, i, j)) + std::abs(sqrt(_gamma * (_gamma - 1) * rhoe.get(0, i, j) / rho.get(0, i, j))));
-                _SDS_uymax[sds.getId()] = std::max(_SDS_uymax[sds.getId()], std::abs(rhou_y.get(1, i, j) / rho.get(0, i, j)) + std::abs(sqrt(_gamma * (_gamma - 1) * rhoe.get(0, i, j) / rho.get(0, i, j))));
+        for (const auto& range: sds.getRanges()) {
+            const int j = range.y;
+            for (int i = range.x; i < range.x + int(range.length); ++i) {
+                if (rho.get(0, i, j) != 0.) {
+                    _SDS_uxmax[sds.getId()] = std::max(_SDS_uxmax[sds.getId()], std::abs(rhou_x.get(1, i, j) / rho.get(0, i, j)) + std::abs(sqrt(_gamma * (_gamma - 1) * rhoe.get(0, i, j) / rho.get(0, i, j))));
+                    _SDS_uymax[sds.getId()] = std::max(_SDS_uymax[sds.getId()], std::abs(rhou_y.get(1, i, j) / rho.get(0, i, j)) + std::abs(sqrt(_gamma * (_gamma - 1) * rhoe.get(0, i, j) / rho.get(0, i, j))));
+                }
             }
         }
     }
@@ -90,6 +95,7 @@ int Hydro8x1::init() {
 
     _domain->addEquation("updateBoundary", std::bind(&Hydro8x1::updateBoundary, this,
                                    std::placeholders::_1, std::placeholders::_2));
+    initSnapshots(*_domain, {"rho", "rhou_x", "rhou_y", "rhoe"});
     return 0;
 }
 
@@ -154,6 +160,7 @@ int Hydro8x1::start() {
         updateDomainUxmax();
         updateDomainUymax();
 
+        snapshot();
         _timerIteration.end();
     }
 
@@ -180,90 +187,89 @@ void Hydro8x1::advection(const SDShared& sds, const std::map< std::string, Quant
     Quantity<real>& rhou_y = *quantityMap.at("rhou_y");
     Quantity<real>& rhoe = *quantityMap.at("rhoe");
 
-    for (const auto& coords: sds) {
-
-        const int i = coords.first;
-        const int j = coords.second;
-
-        // Get values from quantity.
-        unsigned int k_bottom = sds.convert(i, j - 1);
-        unsigned int k_top = sds.convert(i, j + 1);
-        unsigned int k_center = sds.convert(i, j);
-        unsigned int k_left(k_center - 1);
-        unsigned int k_right(k_center + 1);
-
-        real rho_left = rho.get0(k_left);
-        real rho_center = rho.get0(k_center);
-        real rho_right = rho.get0(k_right);
-        real rho_top = rho.get0(k_top);
-        real rho_bottom = rho.get0(k_bottom);
-
-        real rhou_x_left = rhou_x.get0(k_left);
-        real rhou_x_center = rhou_x.get0(k_center);
-        real rhou_x_right = rhou_x.get0(k_right);
-        real rhou_x_top = rhou_x.get0(k_top);
-        real rhou_x_bottom = rhou_x.get0(k_bottom);
-
-        real rhou_y_left = rhou_y.get0(k_left);
-        real rhou_y_center = rhou_y.get0(k_center);
-        real rhou_y_right = rhou_y.get0(k_right);
-        real rhou_y_top = rhou_y.get0(k_top);
-        real rhou_y_bottom = rhou_y.get0(k_bottom);
-
-        real rhoe_left = rhoe.get0(k_left);
-        real rhoe_center = rhoe.get0(k_center);
-        real rhoe_right = rhoe.get0(k_right);
-        real rhoe_top = rhoe.get0(k_top);
-        real rhoe_bottom = rhoe.get0(k_bottom);
-
-        // Computing velocity on nodes
-        real uxCellLeft = (rho_left == 0.) ? 0. : rhou_x_left / rho_left;
-        real uxCellCenter = (rho_center == 0.) ? 0. : rhou_x_center / rho_center;
-        real uxCellRight = (rho_right == 0.) ? 0. : rhou_x_right / rho_right;
-        real uLeft = 0.5 * (uxCellLeft + uxCellCenter);
-        real uRight = 0.5 * (uxCellRight + uxCellCenter);
-
-        real uyCellBottom = (rho_bottom == 0.) ? 0. : rhou_y_bottom / rho_bottom;
-        real uyCellCenter = (rho_center == 0.) ? 0. : rhou_y_center / rho_center;
-        real uyCellTop = (rho_top == 0.) ? 0. : rhou_y_top / rho_top;
-        real uBottom = 0.5 * (uyCellBottom + uyCellCenter);
-        real uTop = 0.5 * (uyCellTop + uyCellCenter);
-
-        // Computing fluxes for all three quantities
-        real rho_fluxLeft = uLeft * ((uLeft > 0.) ? rho_left : rho_center);
-        real rho_fluxRight = uRight * ((uRight < 0.) ? rho_right : rho_center);
-        real rho_fluxBottom = uBottom * ((uBottom > 0.) ? rho_bottom : rho_center);
-        real rho_fluxTop = uTop * ((uTop < 0.) ? rho_top : rho_center);
-
-        real rhou_x_fluxLeft = uLeft * ((uLeft > 0.) ? rhou_x_left : rhou_x_center);
-        real rhou_x_fluxRight = uRight * ((uRight < 0.) ? rhou_x_right : rhou_x_center);
-        real rhou_x_fluxBottom = uBottom * ((uBottom > 0.) ? rhou_x_bottom : rhou_x_center);
-        real rhou_x_fluxTop = uTop * ((uTop < 0.) ? rhou_x_top : rhou_x_center);
-
-        real rhou_y_fluxLeft = uLeft * ((uLeft > 0.) ? rhou_y_left : rhou_y_center);
-        real rhou_y_fluxRight = uRight * ((uRight < 0.) ? rhou_y_right : rhou_y_center);
-        real rhou_y_fluxBottom = uBottom * ((uBottom > 0.) ? rhou_y_bottom : rhou_y_center);
-        real rhou_y_fluxTop = uTop * ((uTop < 0.) ? rhou_y_top : rhou_y_center);
-
-        real rhoe_fluxLeft = uLeft * ((uLeft > 0.) ? rhoe_left : rhoe_center);
-        real rhoe_fluxRight = uRight * ((uRight < 0.) ? rhoe_right : rhoe_center);
-        real rhoe_fluxBottom = uBottom * ((uBottom > 0.) ? rhoe_bottom : rhoe_center);
-        real rhoe_fluxTop = uTop * ((uTop < 0.) ? rhoe_top : rhoe_center);
-
-        // std::cout << "Flux differences " << rho_fluxRight - rho_fluxLeft << " ; " << rho_fluxTop - rho_fluxBottom << std::endl;
-        // std::cout << "Speeds on centers " << uxCellCenter << " " << uyCellCenter << std::endl;
-
-        rho.set1(rho_center - _dt * ((rho_fluxRight - rho_fluxLeft) / _dx + (rho_fluxTop - rho_fluxBottom) / _dy), k_center);
-        rhou_x.set1(rhou_x_center - _dt * ((rhou_x_fluxRight - rhou_x_fluxLeft) / _dx + (rhou_x_fluxTop - rhou_x_fluxBottom) / _dy), k_center);
-        rhou_y.set1(rhou_y_center - _dt * ((rhou_y_fluxRight - rhou_y_fluxLeft) / _dx + (rhou_y_fluxTop - rhou_y_fluxBottom) / _dy), k_center);
-        rhoe.set1(rhoe_center - _dt * ((rhoe_fluxRight - rhoe_fluxLeft) / _dx + (rhoe_fluxTop - rhoe_fluxBottom) / _dy), k_center);
-
-        /*
-        std::cout << i << " ; " << j << std::endl;
-        std::cout << "Values of rho " << rho.get(1, i, j) << std::endl;
-        std::cout << "Values of rhou_x " << rhou_x.get(1, i, j) << std::endl;
-        std::cout << "Values of rhou_y " << rhou_x.get(1, i, j) << std::endl;
-    */
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        for (int i = range.x; i < range.x + int(range.length); ++i) {
+            // Get values from quantity.
+            unsigned int k_bottom = sds.convert(i, j - 1);
+            unsigned int k_top = sds.convert(i, j + 1);
+            unsigned int k_center = sds.convert(i, j);
+            unsigned int k_left(k_center - 1);
+            unsigned int k_right(k_center + 1);
+
+            real rho_left = rho.get0(k_left);
+            real rho_center = rho.get0(k_center);
+            real rho_right = rho.get0(k_right);
+            real rho_top = rho.get0(k_top);
+            real rho_bottom = rho.get0(k_bottom);
+
+            real rhou_x_left = rhou_x.get0(k_left);
+            real rhou_x_center = rhou_x.get0(k_center);
+            real rhou_x_right = rhou_x.get0(k_right);
+            real rhou_x_top = rhou_x.get0(k_top);
+            real rhou_x_bottom = rhou_x.get0(k_bottom);
+
+            real rhou_y_left = rhou_y.get0(k_left);
+            real rhou_y_center = rhou_y.get0(k_center);
+            real rhou_y_right = rhou_y.get0(k_right);
+            real rhou_y_top = rhou_y.get0(k_top);
+            real rhou_y_bottom = rhou_y.get0(k_bottom);
+
+            real rhoe_left = rhoe.get0(k_left);
+            real rhoe_center = rhoe.get0(k_center);
+            real rhoe_right = rhoe.get0(k_right);
+            real rhoe_top = rhoe.get0(k_top);
+            real rhoe_bottom = rhoe.get0(k_bottom);
+
+            // Computing velocity on nodes
+            real uxCellLeft = (rho_left == 0.) ? 0. : rhou_x_left / rho_left;
+            real uxCellCenter = (rho_center == 0.) ? 0. : rhou_x_center / rho_center;
+            real uxCellRight = (rho_right == 0.) ? 0. : rhou_x_right / rho_right;
+            real uLeft = 0.5 * (uxCellLeft + uxCellCenter);
+            real uRight = 0.5 * (uxCellRight + uxCellCenter);
+
+            real uyCellBottom = (rho_bottom == 0.) ? 0. : rhou_y_bottom / rho_bottom;
+            real uyCellCenter = (rho_center == 0.) ? 0. : rhou_y_center / rho_center;
+            real uyCellTop = (rho_top == 0.) ? 0. : rhou_y_top / rho_top;
+            real uBottom = 0.5 * (uyCellBottom + uyCellCenter);
+            real uTop = 0.5 * (uyCellTop + uyCellCenter);
+
+            // Computing fluxes for all three quantities
+            real rho_fluxLeft = uLeft * ((uLeft > 0.) ? rho_left : rho_center);
+            real rho_fluxRight = uRight * ((uRight < 0.) ? rho_right : rho_center);
+            real rho_fluxBottom = uBottom * ((uBottom > 0.) ? rho_bottom : rho_center);
+            real rho_fluxTop = uTop * ((uTop < 0.) ? rho_top : rho_center);
+
+            real rhou_x_fluxLeft = uLeft * ((uLeft > 0.) ? rhou_x_left : rhou_x_center);
+            real rhou_x_fluxRight = uRight * ((uRight < 0.) ? rhou_x_right : rhou_x_center);
+            real rhou_x_fluxBottom = uBottom * ((uBottom > 0.) ? rhou_x_bottom : rhou_x_center);
+            real rhou_x_fluxTop = uTop * ((uTop < 0.) ? rhou_x_top : rhou_x_center);
+
+            real rhou_y_fluxLeft = uLeft * ((uLeft > 0.) ? rhou_y_left : rhou_y_center);
+            real rhou_y_fluxRight = uRight * ((uRight < 0.) ? rhou_y_right : rhou_y_center);
+            real rhou_y_fluxBottom = uBottom * ((uBottom > 0.) ? rhou_y_bottom : rhou_y_center);
+            real rhou_y_fluxTop = uTop * ((uTop < 0.) ? rhou_y_top : rhou_y_center);
+
+            real rhoe_fluxLeft = uLeft * ((uLeft > 0.) ? rhoe_left : rhoe_center);
+            real rhoe_fluxRight = uRight * ((uRight < 0.) ? rhoe_right : rhoe_center);
+            real rhoe_fluxBottom = uBottom * ((uBottom > 0.) ? rhoe_bottom : rhoe_center);
+            real rhoe_fluxTop = uTop * ((uTop < 0.) ? rhoe_top : rhoe_center);
+
+            // std::cout << "Flux differences " << rho_fluxRight - rho_fluxLeft << " ; " << rho_fluxTop - rho_fluxBottom << std::endl;
+            // std::cout << "Speeds on centers " << uxCellCenter << " " << uyCellCenter << std::endl;
+
+            rho.set1(rho_center - _dt * ((rho_fluxRight - rho_fluxLeft) / _dx + (rho_fluxTop - rho_fluxBottom) / _dy), k_center);
+            rhou_x.set1(rhou_x_center - _dt * ((rhou_x_fluxRight - rhou_x_fluxLeft) / _dx + (rhou_x_fluxTop - rhou_x_fluxBottom) / _dy), k_center);
+            rhou_y.set1(rhou_y_center - _dt * ((rhou_y_fluxRight - rhou_y_fluxLeft) / _dx + (rhou_y_fluxTop - rhou_y_fluxBottom) / _dy), k_center);
+            rhoe.set1(rhoe_center - _dt * ((rhoe_fluxRight - rhoe_fluxLeft) / _dx + (rhoe_fluxTop - rhoe_fluxBottom) / _dy), k_center);
+
+            /*
+            std::cout << i << " ; " << j << std::endl;
+            std::cout << "Values of rho " << rho.get(1, i, j) << std::endl;
+            std::cout << "Values of rhou_x " << rhou_x.get(1, i, j) << std::endl;
+            std::cout << "Values of rhou_y " << rhou_x.get(1, i, j) << std::endl;
+        */
+        }
     }
 }
 
@@ -275,62 +281,61 @@ void Hydro8x1::source(const SDShared& sds, const std::map< std::string, Quantity
     Quantity<real>& rhoe = *quantityMap.at("rhoe");
 
     real sdsUxMax(0.), sdsUyMax(0.);
-    for (const auto& coords: sds) {
+    for (const auto& range: sds.getRanges()) {
+        const int j = range.y;
+        for (int i = range.x; i < range.x + int(range.length); ++i) {
+            // Get values from quantity.
+            unsigned int k_bottom = sds.convert(i, j - 1);
+            unsigned int k_top = sds.convert(i, j + 1);
+            unsigned int k_center = sds.convert(i, j);
+            unsigned int k_left(k_center - 1);
+            unsigned int k_right(k_center + 1);
 
-        const int i = coords.first;
-        const int j = coords.second;
+            real rho_left = rho.get0(k_left);
+            real rho_center = rho.get0(k_center);
+            real rho_right = rho.get0(k_right);
+            real rho_bottom = rho.get0(k_bottom);
+            real rho_top = rho.get0(k_top);
 
-        // Get values from quantity.
-        unsigned int k_bottom = sds.convert(i, j - 1);
-        unsigned int k_top = sds.convert(i, j + 1);
-        unsigned int k_center = sds.convert(i, j);
-        unsigned int k_left(k_center - 1);
-        unsigned int k_right(k_center + 1);
+            real rhoe_center = rhoe.get0(k_center);
 
-        real rho_left = rho.get0(k_left);
-        real rho_center = rho.get0(k_center);
-        real rho_right = rho.get0(k_right);
-        real rho_bottom = rho.get0(k_bottom);
-        real rho_top = rho.get0(k_top);
+            // Quantity of motion source term
+            real PLeft = (_gamma - 1) * rhoe.get0(k_left);
+            real PRight = (_gamma - 1) * rhoe.get0(k_right);
+            real PBottom = (_gamma - 1) * rhoe.get0(k_bottom);
+            real PTop = (_gamma - 1) * rhoe.get0(k_top);
 
-        real rhoe_center = rhoe.get0(k_center);
+            real rhou_x1 = rhou_x.get(0, i, j) - _dt * (PRight - PLeft) / (2 * _dx);
+            rhou_x.set1(rhou_x1, k_center);
 
-        // Quantity of motion source term
-        real PLeft = (_gamma - 1) * rhoe.get0(k_left);
-        real PRight = (_gamma - 1) * rhoe.get0(k_right);
-        real PBottom = (_gamma - 1) * rhoe.get0(k_bottom);
-        real PTop = (_gamma - 1) * rhoe.get0(k_top);
+            real rhou_y1 = rhou_y.get(0, i, j) - _dt * (PTop - PBottom) / (2 * _dy);
+            rhou_y.set1(rhou_y1, k_center);
 
-        real rhou_x1 = rhou_x.get(0, i, j) - _dt * (PRight - PLeft) / (2 * _dx);
-        rhou_x.set1(rhou_x1, k_center);
+            // Energy source term
+            real PCenter = (_gamma - 1) * rhoe_center;
 
-        real rhou_y1 = rhou_y.get(0, i, j) - _dt * (PTop - PBottom) / (2 * _dy);
-        rhou_y.set1(rhou_y1, k_center);
+            real uxCellLeft = (rho_left == 0.) ? 0. : rhou_x.get0(k_left) / rho_left;
 
-        // Energy source term
-        real PCenter = (_gamma - 1) * rhoe_center;
+            real uxCellRight = (rho_right == 0.) ? 0. : rhou_x.get0(k_right) / rho_right;
 
-        real uxCellLeft = (rho_left == 0.) ? 0. : rhou_x.get0(k_left) / rho_left;
+            real uyCellBottom = (rho_bottom == 0.) ? 0. : rhou_y.get0(k_bottom) / rho_bottom;
 
-        real uxCellRight = (rho_right == 0.) ? 0. : rhou_x.get0(k_right) / rho_right;
+            real uyCellTop = (rho_top == 0.) ? 0. : rhou_y.get0(k_top) / rho_top;
 
-        real uyCellBottom = (rho_bottom == 0.) ? 0. : rhou_y.get0(k_bottom) / rho_bottom;
+            rhoe.set1(rhoe_center - _dt * PCenter * ((uxCellRight - uxCellLeft) / (2 * _dx) + (uyCellTop - uyCellBottom) / (2 * _dy)), k_center);
 
-        real uyCellTop = (rho_top == 0.) ? 0. : rhou_y.get0(k_top) / rho_top;
+            // Updating umax and uymax
+            if (rho_center != 0.) {
+                // real plus = std::abs(sqrt(_gamma * PCenter / rho0ij));
+                real plus = std::abs(sqrt(_gamma * (_gamma - 1) * rhoe_center / rho_center));
+                real uxMax = std::abs(rhou_x1 / rho_center) + plus;
+                if (sdsUxMax < uxMax)
+                    sdsUxMax = uxMax;
 
-        rhoe.set1(rhoe_center - _dt * PCenter * ((uxCellRight - uxCellLeft) / (2 * _dx) + (uyCellTop - uyCellBottom) / (2 * _dy)), k_center);
-
-        // Updating umax and uymax
-        if (rho_center != 0.) {
-            // real plus = std::abs(sqrt(_gamma * PCenter / rho0ij));
-            real plus = std::abs(sqrt(_gamma * (_gamma - 1) * rhoe_center / rho_center));
-            real uxMax = std::abs(rhou_x1 / rho_center) + plus;
-            if (sdsUxMax < uxMax)
-                sdsUxMax = uxMax;
-
-            real uyMax = std::abs(rhou_y1 / rho_center) + plus;
-            if (sdsUyMax < uyMax)
-                sdsUyMax = uyMax;
+                real uyMax = std::abs(rhou_y1 / rho_center) + plus;
+                if (sdsUyMax < uyMax)
+                    sdsUyMax = uyMax;
+            }
         }
     }
 
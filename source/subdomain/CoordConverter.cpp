@@ -1,21 +1,139 @@
 #include "CoordConverter.hpp"
+#include "exception/exception.hpp"
 #include <iostream>
+#include <algorithm>
+
+const std::string CoordConverter::ROW_MAJOR = "rowmajor";
+const std::string CoordConverter::MORTON = "morton";
+const std::string CoordConverter::HILBERT = "hilbert";
+
+namespace {
+
+    // Interleaves the 16 lower bits of v with zeros.
+    unsigned int spreadBits(unsigned int v) {
+        v &= 0x0000ffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    unsigned int mortonIndex(unsigned int x, unsigned int y) {
+        return spreadBits(x) | (spreadBits(y) << 1);
+    }
+
+    // Distance along the Hilbert curve filling a n x n square (n power of 2).
+    unsigned int hilbertIndex(unsigned int n, unsigned int x, unsigned int y) {
+        unsigned int d(0);
+        for (unsigned int s = n / 2; s > 0; s /= 2) {
+            const unsigned int rx = (x & s) > 0;
+            const unsigned int ry = (y & s) > 0;
+            d += s * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = s - 1 - x;
+                    y = s - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return d;
+    }
+}
 
 CoordConverter::CoordConverter(unsigned int sizeSDD_X,
         unsigned int sizeSDD_Y,
-        unsigned int boundaryThickness):
+        unsigned int boundaryThickness,
+        std::string cellOrder):
     _sizeSDD_X(sizeSDD_X),
     _sizeSDD_Y(sizeSDD_Y),
-    _boundaryThickness(boundaryThickness) {
+    _boundaryThickness(boundaryThickness),
+    _order(ROW_MAJOR_ORDER),
+    _blockLog2(0),
+    _nBlocksX(0),
+    _interiorSize(sizeSDD_X * sizeSDD_Y) {
+
+    if (cellOrder == ROW_MAJOR)
+        return;
+
+    if (cellOrder == MORTON)
+        _order = MORTON_ORDER;
+    else if (cellOrder == HILBERT)
+        _order = HILBERT_ORDER;
+    else
+        exitfail("Unknown cell order: " + cellOrder);
+
+    // Largest power-of-two block fitting in the SDD, shrunk while padding
+    // the SDD to whole blocks wastes more than 1/8 of the interior.
+    const unsigned long long area = (unsigned long long)sizeSDD_X * sizeSDD_Y;
+    const unsigned int minSize = std::min(sizeSDD_X, sizeSDD_Y);
+    while (_blockLog2 < 16 && (2u << _blockLog2) <= minSize)
+        ++_blockLog2;
+
+    while (_blockLog2 > 0) {
+        const unsigned long long blockSize = 1ull << _blockLog2;
+        const unsigned long long paddedX = (sizeSDD_X + blockSize - 1) / blockSize * blockSize;
+        const unsigned long long paddedY = (sizeSDD_Y + blockSize - 1) / blockSize * blockSize;
+        if (paddedX * paddedY * 8 <= area * 9)
+            break;
+        --_blockLog2;
+    }
+
+    const unsigned int blockSize = 1u << _blockLog2;
+    _nBlocksX = (sizeSDD_X + blockSize - 1) / blockSize;
+    const unsigned int nBlocksY = (sizeSDD_Y + blockSize - 1) / blockSize;
+    _interiorSize = _nBlocksX * nBlocksY * blockSize * blockSize;
 }
 
 CoordConverter::CoordConverter(const CoordConverter& coordConverter):
     _sizeSDD_X(coordConverter._sizeSDD_X),
     _sizeSDD_Y(coordConverter._sizeSDD_Y),
-    _boundaryThickness(coordConverter._boundaryThickness) {
+    _boundaryThickness(coordConverter._boundaryThickness),
+    _order(coordConverter._order),
+    _blockLog2(coordConverter._blockLog2),
+    _nBlocksX(coordConverter._nBlocksX),
+    _interiorSize(coordConverter._interiorSize) {
+}
+
+unsigned int CoordConverter::getSize() const {
+    const unsigned int rowSize = _sizeSDD_X + 2 * _boundaryThickness;
+    if (_order == ROW_MAJOR_ORDER)
+        return rowSize * (_sizeSDD_Y + 2 * _boundaryThickness);
+
+    return _interiorSize + 2 * _boundaryThickness * (rowSize + _sizeSDD_Y);
 }
 
-unsigned int CoordConverter::convert(int coordX, int coordY) const {
-    return (coordX + _boundaryThickness) + (coordY + _boundaryThickness) * (_sizeSDD_X + 2 * _boundaryThickness);
+std::string CoordConverter::getCellOrder() const {
+    if (_order == MORTON_ORDER)
+        return MORTON;
+    if (_order == HILBERT_ORDER)
+        return HILBERT;
+    return ROW_MAJOR;
 }
 
+unsigned int CoordConverter::convertCurve(int coordX, int coordY) const {
+    const int sizeX = _sizeSDD_X;
+    const int sizeY = _sizeSDD_Y;
+    const int b = _boundaryThickness;
+
+    if (coordX >= 0 && coordX < sizeX && coordY >= 0 && coordY < sizeY) {
+        const unsigned int mask = (1u << _blockLog2) - 1;
+        const unsigned int block = (coordY >> _blockLog2) * _nBlocksX + (coordX >> _blockLog2);
+        const unsigned int x = coordX & mask;
+        const unsigned int y = coordY & mask;
+        const unsigned int inBlock = (_order == MORTON_ORDER) ? mortonIndex(x, y) : hilbertIndex(mask + 1, x, y);
+        return (block << (2 * _blockLog2)) + inBlock;
+    }
+
+    // Boundary: b rows below, b rows above, then the 2b cells on the sides of
+    // each interior row.
+    const int rowSize = sizeX + 2 * b;
+    if (coordY < 0)
+        return _interiorSize + (coordY + b) * rowSize + (coordX + b);
+    if (coordY >= sizeY)
+        return _interiorSize + (b + coordY - sizeY) * rowSize + (coordX + b);
+
+    const int side = (coordX < 0) ? coordX + b : b + coordX - sizeX;
+    return _interiorSize + 2 * b * rowSize + coordY * 2 * b + side;
+}
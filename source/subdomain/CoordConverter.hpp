@@ -2,17 +2,25 @@
 #define COORDCONVERTER_HPP
 
 /*!
- * @file 
+ * @file
  * @brief Defines class for the converter
  * 2D-coordinates -> memory index
  */
 
+#include <string>
+
 /*!
- * @brief Converts 2D-coordinates to memory index for 
+ * @brief Converts 2D-coordinates to memory index for
  * given SDD size
  *
  * The data on the SDD is stored as a one-dimensional
  * array, hence the need of a converter.
+ *
+ * Cells can be stored row by row (the default) or along a space-filling
+ * curve (Z-order or Hilbert). With a curve, the interior of the SDD is cut
+ * into square blocks of power-of-two side stored one after the other, the
+ * cells of a block following the curve; the boundary cells are stored after
+ * the interior, row by row.
  */
 class CoordConverter {
   public:
@@ -22,9 +30,13 @@ class CoordConverter {
      *
      * @param sizeSDD_X : width of SDD
      * @param sizeSDD_Y : height of SDD
+     * @param boundaryThickness : thickness of the boundary around the SDD
+     * @param cellOrder : order of the cells in memory (ROW_MAJOR, MORTON or
+     * HILBERT)
      */
     CoordConverter(unsigned int sizeSDD_X, unsigned int sizeSDD_Y,
-            unsigned int boundaryThickness);
+            unsigned int boundaryThickness,
+            std::string cellOrder = ROW_MAJOR);
     /*!
      * @brief Copy constructor
      *
@@ -36,10 +48,32 @@ class CoordConverter {
      * @brief convert 2D-coordinates to the memory index of
      * the data on the SDD
      */
-    unsigned int convert(int coordX, int coordY) const;
+    inline unsigned int convert(int coordX, int coordY) const;
+
+    /*!
+     * @brief number of memory slots needed to store a quantity on the SDD,
+     * boundary included
+     */
+    unsigned int getSize() const;
+
+    /*!
+     * @brief order of the cells in memory
+     */
+    std::string getCellOrder() const;
+
+    static const std::string ROW_MAJOR;
+    static const std::string MORTON;
+    static const std::string HILBERT;
 
   private:
 
+    enum Order { ROW_MAJOR_ORDER, MORTON_ORDER, HILBERT_ORDER };
+
+    /*!
+     * @brief memory index of a cell when the cells follow a curve
+     */
+    unsigned int convertCurve(int coordX, int coordY) const;
+
     /*!
      * width of SDD
      */
@@ -50,6 +84,26 @@ class CoordConverter {
     unsigned int _sizeSDD_Y;
     unsigned int _boundaryThickness;
 
+    Order _order;
+    /*!
+     * log2 of the side of the curve blocks
+     */
+    unsigned int _blockLog2;
+    /*!
+     * number of curve blocks on the X-axis
+     */
+    unsigned int _nBlocksX;
+    /*!
+     * number of memory slots used by the interior, padding included
+     */
+    unsigned int _interiorSize;
 };
 
+inline unsigned int CoordConverter::convert(int coordX, int coordY) const {
+    if (_order == ROW_MAJOR_ORDER)
+        return (coordX + _boundaryThickness) + (coordY + _boundaryThickness) * (_sizeSDD_X + 2 * _boundaryThickness);
+
+    return convertCurve(coordX, coordY);
+}
+
 #endif
@@ -16,6 +16,13 @@ Domain::Domain() {
 Domain::~Domain() {
 
     delete _sdd;
+    #ifndef SEQUENTIAL
+    // Released by MPI_Finalize if it was already called.
+    int finalized(0);
+    MPI_Finalized(&finalized);
+    if (!finalized && _SDDComm != MPI_COMM_WORLD)
+        MPI_Comm_free(&_SDDComm);
+    #endif
 }
 
 void Domain::initRect(real lx, real ly,
@@ -43,6 +50,28 @@ void Domain::setOptions(unsigned int nSDD, unsigned int nSDD_X, unsigned int nSD
     _nCommonSDS = nCommonSDS;
 }
 
+void Domain::setExecOption(const std::string& name, const std::string& value) {
+
+    // A misspelt option would silently run with the default value.
+    static const std::vector<std::string> knownOptions = {
+        "affinity", "alignment", "cacheKB", "cellOrder", "dtReduction", "halo",
+        "haloDepth", "haloExchange", "haloRequests", "layout", "output",
+        "sweep", "waitPolicy"};
+    if (std::find(knownOptions.begin(), knownOptions.end(), name) == knownOptions.end())
+        exitfail("Unknown exec option: " + name);
+
+    _execOptionMap[name] = value;
+}
+
+std::string Domain::getExecOption(const std::string& name, const std::string& defaultValue) const {
+
+    auto it = _execOptionMap.find(name);
+    if (it == _execOptionMap.end())
+        return defaultValue;
+
+    return it->second;
+}
+
 unsigned int Domain::getNumberNeighbourSDDs() const {
 
     return _sdd->getNumberNeighbourSDDs();
@@ -91,15 +120,17 @@ void Domain::addQuantity(std::string quantityName) {
     _sdd->addQuantity<real>(quantityName, Number::zero);
 }
 
+void Domain::addQuantityGroup(const std::vector<std::string>& quantityNames) {
+    _sdd->addQuantityGroup<real>(quantityNames, Number::zero, getExecOption("layout", "SoA"));
+}
+
 void Domain::addEquation(std::string eqName, eqType eqFunc) {
     _sdd->addEquation(eqName, eqFunc);
 }
 
-void Domain::buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundaryThickness) {
-    #ifndef SEQUENTIAL
-    MPI_Comm_rank(MPI_COMM_WORLD, &_MPI_rank);
-    #else
-    _MPI_rank = 0;
+void Domain::buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundaryThickness,
+        unsigned int nQuantities) {
+    #ifdef SEQUENTIAL
     assert(_nSDD == 1);
     #endif
 
@@ -107,8 +138,40 @@ void Domain::buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundar
     assert(_Nx % _nSDD_X == 0);
     assert(_Ny % _nSDD_Y == 0);
 
-    _sdd = new SDDistributed(_SDD_Nx, _SDD_Ny, _SDD_BL_X, _SDD_BL_Y, boundaryThickness, neighbourHood, _MPI_rank, _nSDD);
-    _sdd->buildAllSDS(_nSDS, _SDSgeom);
+    _sdd = new SDDistributed(_SDD_Nx, _SDD_Ny, _SDD_BL_X, _SDD_BL_Y, boundaryThickness, neighbourHood, _MPI_rank, _nSDD,
+            getExecOption("cellOrder", CoordConverter::ROW_MAJOR));
+    // "neighbour": the overlap cells are exchanged by one neighbourhood
+    // collective on the Cartesian topology of the processes (see placeSDD).
+    #ifndef SEQUENTIAL
+    _sdd->setComm(_SDDComm, getExecOption("haloExchange", "packed") == "neighbour");
+    #endif
+
+    // All the quantities in one aligned block, shared by the SDDs of a node
+    // to read the overlap cells from each other.
+    const bool sharedExchange(getExecOption("haloExchange", "packed") == "shared");
+    if (sharedExchange && nQuantities == 0)
+        exitfail("The shared halo exchange needs the number of quantities.");
+
+    // The neighbourhood collective only exchanges with the SDDs along the
+    // axes of the Cartesian topology, not with the diagonal ones.
+    if (neighbourHood == 8 && getExecOption("haloExchange", "packed") == "neighbour")
+        exitfail("haloExchange=neighbour can't exchange corners with the diagonal SDDs (e.g. haloDepth > 1).");
+    if (nQuantities > 0)
+        _sdd->initQuantityArena(nQuantities, getExecOption("alignment", "64"), sharedExchange);
+
+    // Rectangle SDSs are sized so that their working set (all the quantities
+    // of all their cells) fits in the private cache of a core.
+    unsigned int maxSDSSize = 0;
+    if (_SDSgeom == Geometry::RECTANGLE) {
+        assert(nQuantities > 0);
+        unsigned long cacheSize = std::stoul(getExecOption("cacheKB", "256")) * 1024;
+        if (cacheSize > 0)
+            maxSDSSize = std::max<unsigned long>(1, cacheSize / (nQuantities * sizeof(real)));
+    }
+    _sdd->buildAllSDS(_nSDS, _SDSgeom, maxSDSSize);
+
+    // The geometry may build more SDSs than asked.
+    _nSDS = _sdd->getSDS().size();
 
     // Communicating size and coords of SDD
     _SDD_BLandSize_List.resize(_nSDD);
@@ -120,11 +183,83 @@ void Domain::buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundar
     _SDD_BLandSize_List[_MPI_rank] = BLandSize;
 
     #ifndef SEQUENTIAL
+    MPI_Allgather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, _SDD_BLandSize_List.data(), 4, MPI_INT, _SDDComm);
+    #endif
+
+    buildOwnerIndex();
+}
+
+void Domain::buildOwnerIndex() {
+
+    _ownerGrid.clear();
+    _slabStartX.clear();
+    _slabOwners.clear();
+
+    // Regular grid: all the SDDs have the size of the grid and their own place.
+    const int sizeX(_Nx / _nSDD_X), sizeY(_Ny / _nSDD_Y);
+    bool regular(_nSDD_X * _nSDD_Y == _nSDD);
+    std::vector<int> ownerGrid(_nSDD, -1);
+    for (unsigned int id = 0; id < _nSDD && regular; ++id) {
+        const std::array<int, 4>& BLandSize(_SDD_BLandSize_List[id]);
+        regular = (BLandSize[2] == sizeX && BLandSize[3] == sizeY &&
+                   BLandSize[0] % sizeX == 0 && BLandSize[1] % sizeY == 0);
+        if (!regular)
+            break;
+
+        int& owner(ownerGrid[(BLandSize[1] / sizeY) * _nSDD_X + BLandSize[0] / sizeX]);
+        regular = (owner < 0);
+        owner = id;
+    }
+
+    if (regular) {
+        _ownerGrid.swap(ownerGrid);
+        return;
+    }
+
+    // Slabs between the consecutive sides of the SDDs along x.
+    for (const auto& BLandSize: _SDD_BLandSize_List) {
+        _slabStartX.push_back(BLandSize[0]);
+        _slabStartX.push_back(BLandSize[0] + BLandSize[2]);
+    }
+    std::sort(_slabStartX.begin(), _slabStartX.end());
+    _slabStartX.erase(std::unique(_slabStartX.begin(), _slabStartX.end()), _slabStartX.end());
+
+    _slabOwners.resize(_slabStartX.size());
     for (unsigned int id = 0; id < _nSDD; ++id) {
-        //std::cerr << "MPI_Bcast(..., " << 4 << ", " << MPI_INT << ", " << id << ", " << MPI_COMM_WORLD << ");\n";
-        MPI_Bcast(&(_SDD_BLandSize_List[id]), 4, MPI_INT, id, MPI_COMM_WORLD);
+        const std::array<int, 4>& BLandSize(_SDD_BLandSize_List[id]);
+        auto slab = std::lower_bound(_slabStartX.begin(), _slabStartX.end(), BLandSize[0]);
+        for (; slab != _slabStartX.end() && *slab < BLandSize[0] + BLandSize[2]; ++slab)
+            _slabOwners[slab - _slabStartX.begin()].push_back(std::make_pair(BLandSize[1], id));
     }
-    #endif
+
+    for (auto& owners: _slabOwners)
+        std::sort(owners.begin(), owners.end());
+}
+
+int Domain::getOwner(int coordX, int coordY) const {
+
+    if (!_ownerGrid.empty()) {
+        const int sizeX(_Nx / _nSDD_X), sizeY(_Ny / _nSDD_Y);
+        return _ownerGrid[(coordY / sizeY) * _nSDD_X + coordX / sizeX];
+    }
+
+    // Last slab starting before x, then last SDD of the slab starting
+    // below y.
+    auto slab = std::upper_bound(_slabStartX.begin(), _slabStartX.end(), coordX);
+    if (slab == _slabStartX.begin())
+        return -1;
+
+    const auto& owners(_slabOwners[slab - _slabStartX.begin() - 1]);
+    auto owner = std::upper_bound(owners.begin(), owners.end(), std::make_pair(coordY, _nSDD));
+    if (owner == owners.begin())
+        return -1;
+
+    --owner;
+    const std::array<int, 4>& BLandSize(_SDD_BLandSize_List[owner->second]);
+    if (coordX >= BLandSize[0] + BLandSize[2] || coordY >= BLandSize[1] + BLandSize[3])
+        return -1;
+
+    return owner->second;
 }
 
 void Domain::buildCommunicationMap() {
@@ -137,13 +272,23 @@ void Domain::buildCommunicationMap() {
     #ifndef SEQUENTIAL
     MPI_Barrier(MPI_COMM_WORLD);
     #endif
-    _sdd->buildSendMap();
+    const std::string haloRequests(getExecOption("haloRequests", "persistent"));
+    if (haloRequests != "persistent" && haloRequests != "immediate")
+        exitfail("Unknown halo requests: " + haloRequests);
+    const std::string haloExchange(getExecOption("haloExchange", "packed"));
+    if (haloExchange != "packed" && haloExchange != "datatype" && haloExchange != "shared" && haloExchange != "neighbour")
+        exitfail("Unknown halo exchange: " + haloExchange);
+
+    _sdd->buildSendMap(haloRequests == "persistent", haloExchange == "datatype");
 
     // Once we have the boundary cells, dispatch them among the SDS available.
     _sdd->dispatchBoundaryCell(dirichletCellMap, timeVaryingCellMap, neumannCellMap);
 
     // Dispatch overlap cells.
     _sdd->dispatchOverlapCell();
+
+    // SDSs that can be computed during the communications.
+    _sdd->classifySDS();
 }
 
 void Domain::execEquation(const std::string& eqName) {
@@ -151,6 +296,34 @@ void Domain::execEquation(const std::string& eqName) {
     _sdd->execEquation(eqName);
 }
 
+void Domain::addSplitEquation(std::string eqName, eqType eqFunc) {
+    _sdd->addSplitEquation(eqName, eqFunc);
+}
+
+void Domain::execInteriorEquation(const std::string& eqName) {
+
+    _sdd->execInteriorEquation(eqName);
+}
+
+void Domain::execBorderEquation(const std::string& eqName) {
+
+    _sdd->execBorderEquation(eqName);
+}
+
+void Domain::buildHaloSDS(unsigned int nLayers) {
+
+    _sdd->buildHaloSDS(nLayers);
+}
+
+void Domain::addHaloEquation(std::string eqName, eqType eqFunc) {
+    _sdd->addHaloEquation(eqName, eqFunc);
+}
+
+void Domain::execHaloEquation(const std::string& eqName, unsigned int width) {
+
+    _sdd->execHaloEquation(eqName, width);
+}
+
 int Domain::getBoundarySide(std::pair<int, int> coords) const {
 
     if (coords.first < 0)
@@ -175,23 +348,13 @@ Domain::getSDDandCoords(std::pair<int, int> coordsOnDomain) const {
         // Getting SDDid and coords of "real" cell
         // corresponding to the coords on domain
 
-        // Finding the correct SDD
-        for (unsigned int i = 0; i < _nSDD; i++) {
-
-            // If coord is in rectangle then it is found
-            std::array<int, 4> BLandSize = _SDD_BLandSize_List.at(i);
-            std::pair<int, int> BL(BLandSize[0], BLandSize[1]);
-            std::pair<int, int> SDDsize(BLandSize[2], BLandSize[3]);
-            if (coordsOnDomain.first >= BL.first &&
-                coordsOnDomain.first < BL.first + SDDsize.first &&
-                coordsOnDomain.second >= BL.second &&
-                coordsOnDomain.second < BL.second + SDDsize.second) {
-
-                std::pair<int, int>
-                coordsOnCorrectSDD(coordsOnDomain.first - BL.first,
-                                   coordsOnDomain.second - BL.second);
-                return std::pair< int, std::pair<int, int> >(i, coordsOnCorrectSDD);
-            }
+        const int SDDid(getOwner(coordsOnDomain.first, coordsOnDomain.second));
+        if (SDDid >= 0) {
+            std::array<int, 4> BLandSize = _SDD_BLandSize_List[SDDid];
+            std::pair<int, int>
+            coordsOnCorrectSDD(coordsOnDomain.first - BLandSize[0],
+                               coordsOnDomain.second - BLandSize[1]);
+            return std::pair< int, std::pair<int, int> >(SDDid, coordsOnCorrectSDD);
         }
     }
 
@@ -428,55 +591,16 @@ void SDDistributed::buildRecvMap(const Domain& domain,
     }
 }
 
-void SDDistributed::buildSendMap() {
-    #ifndef SEQUENTIAL
-    unsigned int nSDD = _nSDD;
-    std::vector<int> numberOfCellsToRecv(nSDD, 0); // data sent to other SDDs
-    std::vector<int> numberOfCellsToSend(nSDD, 0); // data recved from other SDDs
-
-    std::vector<MPI_Status> statuses(nSDD);
-
-    // Counting number of cells to receive based on recv map
-    for (auto const &it : _MPIRecv_map)
-        numberOfCellsToRecv[it.second.first]++;
-
-    // Sending and receiving the number of cells needed
-    for (unsigned int SDDto = 0; SDDto < nSDD; ++SDDto) {
-
-        // Not sending messages to oneself...
-        if (SDDto == _id)
-            continue;
-
-        // Tag: SDDfrom * nSDD + SDDto
-        MPI_Sendrecv(&numberOfCellsToRecv[SDDto], 1, MPI_INT, SDDto, _id * nSDD + SDDto,
-                &numberOfCellsToSend[SDDto], 1, MPI_INT, SDDto, SDDto * nSDD + _id, MPI_COMM_WORLD, &statuses[SDDto]);
-        //std::cout << _id << " -> " << SDDto << " --- " << numberOfCellsToRecv[SDDto] << " ; " << numberOfCellsToSend[SDDto] << std::endl;
-    }
-
-    // Now that we know how many cells we have to receive and send, we can...
-    // receive and send
-
-    // data recved from other SDDs, used to build the Send map
-    std::vector< std::vector< std::array<int, 4> > > cellsToRecv(nSDD);
-    // data sent to other SDDs, based on the Recv map
-    std::vector< std::vector< std::array<int, 4> > > cellsToSend(nSDD);
-
-    // Initializing cells to receive based on Recv map, and arrays for Send
-    // map
-    for (unsigned int SDDto = 0; SDDto < nSDD; ++SDDto) {
-
-        // Not sending messages to oneself...
-        if (SDDto == _id)
-            continue;
-
-        // Array sizes should be EXACTLY what is reserved
-        // and not more, since arrays were just initialized to default
-        // capacity, ie. 0
-        cellsToSend[SDDto].resize(numberOfCellsToSend[SDDto]);
-        cellsToRecv[SDDto].reserve(numberOfCellsToRecv[SDDto]);
-    }
+void SDDistributed::buildSendMap(bool persistentRequests, bool derivedDatatypes) {
+    _persistentRequests = persistentRequests;
+    _derivedDatatypes = derivedDatatypes;
 
+    #ifndef SEQUENTIAL
+    // Coordinates here and on the SDD owning them of the cells to receive.
+    std::map< unsigned int, std::vector< std::array<int, 4> > > cellsToRecv;
     for (auto const &it : _MPIRecv_map) {
+        if (it.second.first == _id)
+            continue;
 
         // Init correspondence here
         std::array<int, 4> coordsCorresp;
@@ -487,37 +611,61 @@ void SDDistributed::buildSendMap() {
         cellsToRecv[it.second.first].push_back(coordsCorresp);
     }
 
-    // Send messages
-    for (unsigned int SDDto = 0; SDDto < nSDD; ++SDDto) {
-
-        // Not sending messages to oneself...
-        if (SDDto == _id)
-            continue;
+    // Sparse exchange of the lists with the neighbours only (NBX): the lists
+    // are sent synchronously, and once they are all received this SDD enters
+    // a barrier. The lists of the others are received until the barrier is
+    // complete, that is until all the lists have been received.
+    const int tag(0);
+    std::vector<MPI_Request> listRequests;
+    for (auto& it: cellsToRecv) {
+        listRequests.push_back(MPI_REQUEST_NULL);
+        MPI_Issend(it.second.data(), 4 * it.second.size(), MPI_INT, it.first, tag, _comm, &listRequests.back());
+    }
 
-        // Tag: SDDfrom * nSDD + SDDto
-        MPI_Sendrecv(&cellsToRecv[SDDto][0], 4 * numberOfCellsToRecv[SDDto],
-                    MPI_INT, SDDto, _id * nSDD + SDDto,
-                &cellsToSend[SDDto][0], 4 * numberOfCellsToSend[SDDto],
-                    MPI_INT, SDDto, SDDto * nSDD + _id,
-                MPI_COMM_WORLD, &statuses[SDDto]);
+    std::map< unsigned int, std::vector< std::array<int, 4> > > cellsToSend;
+    MPI_Request barrierRequest(MPI_REQUEST_NULL);
+    bool inBarrier(false);
+    int done(0);
+    while (!done) {
+        int arrived(0);
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, tag, _comm, &arrived, &status);
+        if (arrived) {
+            int count(0);
+            MPI_Get_count(&status, MPI_INT, &count);
+            std::vector< std::array<int, 4> >& cells(cellsToSend[status.MPI_SOURCE]);
+            cells.resize(count / 4);
+            MPI_Recv(cells.data(), count, MPI_INT, status.MPI_SOURCE, tag, _comm, MPI_STATUS_IGNORE);
+        }
 
-        // Parse the received message
-        for (int i = 0; i < numberOfCellsToSend[SDDto]; ++i) {
+        if (inBarrier) {
+            MPI_Test(&barrierRequest, &done, MPI_STATUS_IGNORE);
+        } else {
+            int sent(0);
+            MPI_Testall(listRequests.size(), listRequests.data(), &sent, MPI_STATUSES_IGNORE);
+            if (sent) {
+                MPI_Ibarrier(_comm, &barrierRequest);
+                inBarrier = true;
+            }
+        }
+    }
 
-            std::array<int, 4> coordsCorresp = cellsToSend[SDDto][i];
+    // Parse the received lists
+    for (auto const& it: cellsToSend) {
+        const unsigned int SDDto(it.first);
+        for (const auto& coordsCorresp: it.second) {
             std::pair<int, std::pair<int, int> >
                 thereCoordsAndSDD(SDDto,
                         std::pair<int, int>(coordsCorresp[0], coordsCorresp[1]));
             std::pair<int, int> hereCoords(coordsCorresp[2], coordsCorresp[3]);
             _MPISend_map[thereCoordsAndSDD] = hereCoords;
-            //std::cout << thereCoordsAndSDD << " -> " <<  _MPISend_map[thereCoordsAndSDD] << std::endl;
         }
 
         // To reserve the size of the buffer init for 4 quantities.
-        if (numberOfCellsToSend[SDDto] > 0) {
+        if (!it.second.empty()) {
             _sendBuffer[SDDto] = nullptr;
             _recvBuffer[SDDto] = nullptr;
-            _sendIndexVector[SDDto].reserve(numberOfCellsToSend[SDDto]);
+            _sendIndexVector[SDDto].reserve(it.second.size());
         }
     }
 
@@ -554,14 +702,18 @@ void SDDistributed::buildSendMap() {
             exitfail("Could not find SDD in neighbourhood.");
     }
 
-    // shuffle vector to dilute the effect of always start with the lower ranking.
-    std::random_shuffle(_neighbourSDDVector.begin(), _neighbourSDDVector.end());
+    _messageSDDVector = _neighbourSDDVector;
 
-    _requestArray = new MPI_Request[_neighbourSDDVector.size() * 2];
-    _statusArray = new MPI_Status[_neighbourSDDVector.size() * 2];
+    // With datatypes, one message per quantity. One collective with the
+    // Cartesian topology.
+    size_t nRequests(_neighbourSDDVector.size() * 2 * (_derivedDatatypes ? _quantityMap.size() : 1));
+    if (_cartComm != MPI_COMM_NULL)
+        nRequests = 1;
+    _requestArray = new MPI_Request[nRequests];
+    _statusArray = new MPI_Status[nRequests];
 
     // Sync processes
-    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Barrier(_comm);
     //std::cout << "Sync done" << std::endl;
 
     // Use to speed-up structures to copy data into buffers.
@@ -581,18 +733,34 @@ void SDDistributed::buildSendMap() {
     if (_quantityMap.empty())
         exitfail("At this point, the quantities must be loaded in the map.");
 
+    // With the neighbourhood collective, the buffers are parts of one block.
+    if (_cartComm != MPI_COMM_NULL) {
+        size_t blockSize(0);
+        for (const auto& SDDid: _neighbourSDDVector)
+            blockSize += _sendIndexVector[SDDid].size() * _quantityMap.size();
+        _sendBlock.reset(new real[blockSize]);
+        _recvBlock.reset(new real[blockSize]);
+    }
+
+    size_t blockPos(0);
     for (const auto& SDDid: _neighbourSDDVector) {
         size_t s(_sendIndexVector[SDDid].size() * _quantityMap.size());
 
-        if (_bufferSize.find(SDDid) != _bufferSize.end()) {
+        if (_bufferSize.find(SDDid) != _bufferSize.end() && _sendBlock == nullptr) {
             std::cout << "delete buffer pointer in " << _id << std::endl;
             delete[] _sendBuffer[SDDid];
             delete[] _recvBuffer[SDDid];
         }
 
         _bufferSize[SDDid] = s;
-        _sendBuffer[SDDid] = new real[s];
-        _recvBuffer[SDDid] = new real[s];
+        if (_sendBlock != nullptr) {
+            _sendBuffer[SDDid] = _sendBlock.get() + blockPos;
+            _recvBuffer[SDDid] = _recvBlock.get() + blockPos;
+            blockPos += s;
+        } else {
+            _sendBuffer[SDDid] = new real[s];
+            _recvBuffer[SDDid] = new real[s];
+        }
 
         //std::cout << "allocate buffer pointer in " << _id << " with size" << s << std::endl;
         for (size_t i(0); i < s; ++i){
@@ -600,6 +768,39 @@ void SDDistributed::buildSendMap() {
             _recvBuffer[SDDid][i] = 0.;
         }
     }
+
+    if (_cartComm != MPI_COMM_NULL) {
+        buildNeighbourExchange();
+        return;
+    }
+
+    if (_derivedDatatypes) {
+        buildOverlapDatatypes();
+        return;
+    }
+
+    if (_sharedExchange)
+        buildSharedExchange();
+
+    // Neighbours, buffers, sizes and tags don't change anymore: the requests
+    // of the exchange are built once and started at each iteration.
+    _lastRequestArraySize = 0;
+    if (_persistentRequests) {
+        for (const auto& toSDDid: _messageSDDVector) {
+            MPI_Request request;
+            MPI_Recv_init(_recvBuffer[toSDDid], _bufferSize[toSDDid],
+                          MPI_REALTYPE, toSDDid, toSDDid * _nSDD + _id,
+                          _comm, &request);
+            _persistentRequestVector.push_back(request);
+            _requestArray[_lastRequestArraySize++] = request;
+
+            MPI_Send_init(_sendBuffer[toSDDid], _bufferSize[toSDDid],
+                          MPI_REALTYPE, toSDDid, _id * _nSDD + toSDDid,
+                          _comm, &request);
+            _persistentRequestVector.push_back(request);
+            _requestArray[_lastRequestArraySize++] = request;
+        }
+    }
     #endif
 }
 
@@ -618,6 +819,22 @@ void Domain::updateOverlapCells() {
     _sdd->parseOverlapCell();
 }
 
+void Domain::startOverlapCells() {
+    if (_nSDD < 2)
+        return;
+
+    _sdd->copyOverlapCell();
+    _sdd->sendOverlapCell();
+}
+
+void Domain::finishOverlapCells() {
+    if (_nSDD < 2)
+        return;
+
+    _sdd->waitOverlapCell();
+    _sdd->parseOverlapCell();
+}
+
 void Domain::printState(std::string quantityName) {
 
     for (unsigned int i = 0; i < _SDD_Nx; i++) {
@@ -632,7 +849,12 @@ void Domain::printState(std::string quantityName) {
 
 void Domain::buildThreads() {
 
-    _sdd->initThreadPool(_nThreads, _nCommonSDS);
+    // The workers steal the tasks of each other, there is no common list anymore.
+    if (_nCommonSDS > 0 && _MPI_rank == 0)
+        WARNING("nCommonSDS is ignored, the threads balance the SDSs by work stealing.");
+
+    _sdd->initThreadPool(_nThreads, getExecOption("waitPolicy", "spin"),
+            getExecOption("affinity", "none"));
 }
 
 void Domain::setSDDInfo(unsigned int BL_X, unsigned int BL_Y,
@@ -644,6 +866,34 @@ void Domain::setSDDInfo(unsigned int BL_X, unsigned int BL_Y,
     _SDD_Ny = Ny;
 }
 
+int Domain::placeSDD(bool periodicX, bool periodicY) {
+
+    #ifndef SEQUENTIAL
+    if (getExecOption("haloExchange", "packed") == "neighbour") {
+        // MPI may reorder the processes on the topology of the exchange to
+        // put the neighbour SDDs close on the machine: a process takes the
+        // SDD of its coordinates (y, x), whose id y * nSDD_X + x is its rank
+        // in the Cartesian communicator.
+        int nProcesses(0);
+        MPI_Comm_size(MPI_COMM_WORLD, &nProcesses);
+        if (_nSDD_X * _nSDD_Y != _nSDD || int(_nSDD) != nProcesses)
+            exitfail("haloExchange=neighbour needs one process per SDD of a regular grid of SDDs.");
+
+        int dims[2] = {int(_nSDD_Y), int(_nSDD_X)};
+        int periods[2] = {periodicY, periodicX};
+        MPI_Cart_create(MPI_COMM_WORLD, 2, dims, periods, 1, &_SDDComm);
+        MPI_Comm_rank(_SDDComm, &_MPI_rank);
+    } else {
+        MPI_Comm_rank(MPI_COMM_WORLD, &_MPI_rank);
+    }
+    #else
+    (void)periodicX; (void)periodicY;
+    _MPI_rank = 0;
+    #endif
+
+    return _MPI_rank;
+}
+
 SDDistributed& Domain::getSDD() {
 
     return *_sdd;
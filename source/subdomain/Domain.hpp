@@ -60,11 +60,31 @@ class Domain {
      * @param nSDS number of SDS per SDD
      * @param SDSgeom type of SDS split
      * @param nThreads number of threads per SDD
+     * @param nCommonSDS kept for the exec options format, ignored
      */
     void setOptions(unsigned int nSDD, unsigned int nSDD_X, unsigned int nSDD_Y,
             unsigned int nSDS, std::string SDSgeom,
             unsigned int nThreads, unsigned int nCommonSDS);
 
+    /*!
+     * @brief Sets an optional execution option, given as name=value in the
+     * execution options file. Fails on an unknown name.
+     *
+     * @param name name of the option
+     * @param value value of the option as read in the file
+     */
+    void setExecOption(const std::string& name, const std::string& value);
+
+    /*!
+     * @brief Returns the value of an optional execution option.
+     *
+     * @param name name of the option
+     * @param defaultValue value returned if the option was not set
+     *
+     * @return value of the option
+     */
+    std::string getExecOption(const std::string& name, const std::string& defaultValue) const;
+
     /*!
      * @brief Returns the non-modifiable width of the domain.
      *
@@ -192,6 +212,14 @@ class Domain {
      * @param name of new quantity
      */
     void addQuantity(std::string quantityName);
+
+    /*!
+     * @brief Adds quantities used together by the scheme, stored according
+     * to the "layout" execution option (SoA or AoSoA).
+     *
+     * @param names of new quantities
+     */
+    void addQuantityGroup(const std::vector<std::string>& quantityNames);
     /*!
      * @brief Adds function that resolves a new equation on a SDS to be computed
      * for each iteration by the domain.
@@ -205,8 +233,18 @@ class Domain {
      *
      * This creates the SDDs and their SDSs according to options set in
      * function setOptions, that has to be called before calling this function.
+     *
+     * @param neighbourHood number of neighbours of a cell (4 or 8)
+     * @param boundaryThickness number of overlap/boundary cell layers
+     * @param nQuantities number of quantities used by the scheme, used to
+     * size the SDSs to the cache (option cacheKB, rectangle geometry) and
+     * the memory block holding them (option alignment: 64 or hugepage)
+     *
+     * The memory order of the cells is read from option cellOrder
+     * (rowmajor, morton or hilbert, see CoordConverter).
      */
-    void buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundaryThickness);
+    void buildSubDomainsMPI(unsigned int neighbourHood, unsigned int boundaryThickness,
+            unsigned int nQuantities);
     /*!
      * @brief Builds all info needed by the domain to compute the boundary
      * according to the boundary conditions set on boundary cells, and overlap cells.
@@ -217,7 +255,9 @@ class Domain {
      * @brief Builds the task pool for each SDD.
      *
      * This can only be called after options were set and subdomains
-     * were built.
+     * were built. Idle threads wait according to option waitPolicy
+     * (spin, backoff or park) and are pinned according to option affinity
+     * (none, compact, scatter or a list of cores), see ThreadPool.
      */
     void buildThreads();
 
@@ -227,6 +267,30 @@ class Domain {
      */
     void execEquation(const std::string& eqName);
 
+    /*!
+     * @brief Adds an equation that can be computed in two parts: on the
+     * interior SDSs, that do not read overlap cells, while the overlap cells
+     * are communicated, then on the border SDSs.
+     *
+     * @param equation function
+     */
+    void addSplitEquation(std::string eqName, eqType eqFunc);
+    void execInteriorEquation(const std::string& eqName);
+    void execBorderEquation(const std::string& eqName);
+
+    /*!
+     * @brief Deep halo: the SDD keeps nLayers ghost layers computed
+     * redundantly between two exchanges. An equation added with
+     * addHaloEquation is computed on the ghost layers 1 to width by
+     * execHaloEquation.
+     *
+     * @param nLayers : number of ghost layers, less than the boundary
+     * thickness
+     */
+    void buildHaloSDS(unsigned int nLayers);
+    void addHaloEquation(std::string eqName, eqType eqFunc);
+    void execHaloEquation(const std::string& eqName, unsigned int width);
+
     /*!
      * @brief updates overlap cells of all SDDs according to their
      * values on reference cells on other SDDs, for a given quantity.
@@ -234,6 +298,15 @@ class Domain {
      */
     void updateOverlapCells();
 
+    /*!
+     * @brief updateOverlapCells in two phases: startOverlapCells posts the
+     * communications, finishOverlapCells waits for them and writes the
+     * overlap cells. The interior part of split equations can be computed
+     * in between.
+     */
+    void startOverlapCells();
+    void finishOverlapCells();
+
     /*! @brief Returns non-modifiable id of SDD and coordinates on SDD of cell
      * given by its coordinates on the domain.
      *
@@ -277,6 +350,22 @@ class Domain {
     void setSDDInfo(unsigned int BL_X, unsigned int BL_Y,
             unsigned int Nx, unsigned int Ny);
 
+    /*!
+     * @brief Places the process on a SDD of the grid
+     *
+     * The SDD id is the rank of the process in the communicator of the SDDs.
+     * With option haloExchange=neighbour, it is the Cartesian topology of
+     * the exchange, on which MPI may reorder the processes to match the
+     * machine. Otherwise it is MPI_COMM_WORLD. The domain info and exec
+     * options have to be loaded.
+     *
+     * @param periodicX, periodicY : the boundary conditions are periodic
+     * along the axis, the topology wraps around it
+     *
+     * @return id of the SDD of the process (its sddN input directory)
+     */
+    int placeSDD(bool periodicX, bool periodicY);
+
     /*!
      * @brief Returns reference to SDD possessed by this
      * MPI node
@@ -297,8 +386,34 @@ class Domain {
 
   private:
 
+    /*!
+     * @brief Builds the index of the owners of the cells, once the
+     * rectangles of all the SDDs are known.
+     */
+    void buildOwnerIndex();
+
+    /*!
+     * @brief Returns the id of the SDD owning a cell inside the domain, -1
+     * if there is none.
+     */
+    int getOwner(int coordX, int coordY) const;
+
     std::vector< std::array<int, 4> > _SDD_BLandSize_List;
 
+    /*!
+     * owner of each place of the grid when the SDDs make a regular grid
+     * (row by row), empty otherwise
+     */
+    std::vector<int> _ownerGrid;
+
+    /*!
+     * otherwise the domain is cut in slabs along x at the sides of the SDDs:
+     * start of each slab, and the SDDs crossing it sorted by their bottom
+     * (bottom, id)
+     */
+    std::vector<int> _slabStartX;
+    std::vector< std::vector< std::pair<int, unsigned int> > > _slabOwners;
+
     std::map< unsigned int, std::pair<int, int> > _uidToCoords;
     std::map< std::pair<int, int>, unsigned int > _coordsToUid;
 
@@ -319,9 +434,13 @@ class Domain {
     std::string _SDSgeom;
     unsigned int _nThreads = 0;
     unsigned int _nCommonSDS = 0;
+    std::map<std::string, std::string> _execOptionMap;
 
     // MPI Variables
     int _MPI_rank;
+    #ifndef SEQUENTIAL
+    MPI_Comm _SDDComm = MPI_COMM_WORLD; // the rank of a process is its SDD id
+    #endif
     SDDistributed* _sdd; // Each proc possesses one SDD
 
     int _SDD_BL_X;
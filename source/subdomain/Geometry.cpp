@@ -14,22 +14,27 @@ const std::string Geometry::TRIANGLE = "triangle";
 const std::string Geometry::AMR = "amr";
 
 Geometry::Geometry(int bottomLeftX, int bottomLeftY,
-            unsigned int sizeX, unsigned int sizeY):
+            unsigned int sizeX, unsigned int sizeY,
+            const CoordConverter& coordConverter):
     _bottomLeftX(bottomLeftX),
     _bottomLeftY(bottomLeftY),
     _topRightX(bottomLeftX + sizeX - 1),
     _topRightY(bottomLeftY + sizeY - 1),
     _sizeX(sizeX),
-    _sizeY(sizeY) {
+    _sizeY(sizeY),
+    _coordConverter(coordConverter) {
 }
 
-std::vector< std::vector< std::pair<int, int> > >
+std::vector< std::vector<CellRange> >
 Geometry::buildGeometry(unsigned int nShapes,
-        std::string geomType) {
+        std::string geomType, unsigned int maxShapeSize) {
 
     nShapes = std::min<unsigned int>(nShapes, _sizeX * _sizeY);
 
-    std::vector< std::vector< std::pair<int, int> > > geometry;
+    if (geomType == RECTANGLE)
+        return buildTiles(nShapes, maxShapeSize);
+
+    std::vector< std::vector<CellRange> > geometry;
     geometry.reserve(nShapes);
 
     if(geomType == RANDOM) {
@@ -47,7 +52,7 @@ Geometry::buildGeometry(unsigned int nShapes,
                 randomShape.push_back(allRect.back());
                 allRect.pop_back();
             }
-            geometry.push_back(randomShape);
+            geometry.push_back(toRanges(randomShape.begin(), randomShape.end()));
             randomShape.clear();
         }
         // For the last line, we push it all the way
@@ -57,11 +62,24 @@ Geometry::buildGeometry(unsigned int nShapes,
             randomShape.push_back(*it);
             ++i;
         }
-        geometry.push_back(randomShape);
+        geometry.push_back(toRanges(randomShape.begin(), randomShape.end()));
+    }
+
+    else if (_coordConverter.getCellOrder() != CoordConverter::ROW_MAJOR) {
 
-        int totalSize = 0;
-        for (unsigned int i = 0; i < geometry.size(); i++) {
-            totalSize += geometry[i].size();
+        // Lines along the memory curve, balanced as below.
+        std::vector<std::pair <int, int> >
+            allRect = buildRectangle(_bottomLeftX, _bottomLeftY,
+                    _sizeX, _sizeY);
+        sortByMemoryIndex(allRect);
+
+        unsigned int L = _sizeX * _sizeY / nShapes;
+        unsigned int n = _sizeX * _sizeY % nShapes;
+        auto first = allRect.begin();
+        for (unsigned int i = 0; i < nShapes; i++) {
+            auto last = first + L + (i < n ? 1 : 0);
+            geometry.push_back(toRanges(first, last));
+            first = last;
         }
     }
 
@@ -112,6 +130,61 @@ Geometry::buildGeometry(unsigned int nShapes,
 
 }
 
+std::vector< std::vector<CellRange> >
+Geometry::buildTiles(unsigned int nShapes, unsigned int maxShapeSize) {
+
+    // Number of tiles along each axis: cut the longest side of the current
+    // tile until there are enough tiles and each of them is small enough.
+    // Cutting along y first keeps the tile rows (contiguous in memory) long.
+    unsigned int nTilesX = 1;
+    unsigned int nTilesY = 1;
+    while (true) {
+        unsigned int tileSizeX = (_sizeX + nTilesX - 1) / nTilesX;
+        unsigned int tileSizeY = (_sizeY + nTilesY - 1) / nTilesY;
+
+        if (nTilesX * nTilesY >= nShapes && (maxShapeSize == 0 || tileSizeX * tileSizeY <= maxShapeSize))
+            break;
+
+        if (tileSizeY >= tileSizeX && nTilesY < _sizeY)
+            ++nTilesY;
+        else if (nTilesX < _sizeX)
+            ++nTilesX;
+        else if (nTilesY < _sizeY)
+            ++nTilesY;
+        else
+            break;
+    }
+
+    std::vector< std::vector<CellRange> > geometry;
+    geometry.reserve(nTilesX * nTilesY);
+
+    for (unsigned int ty = 0; ty < nTilesY; ++ty) {
+        // Balanced split: sizes differ by at most one cell.
+        unsigned int startY = (ty * _sizeY) / nTilesY;
+        unsigned int endY = ((ty + 1) * _sizeY) / nTilesY;
+
+        for (unsigned int k = 0; k < nTilesX; ++k) {
+            // Serpentine order: odd rows of tiles go from right to left.
+            unsigned int tx = (ty % 2 == 0) ? k : nTilesX - 1 - k;
+            unsigned int startX = (tx * _sizeX) / nTilesX;
+            unsigned int endX = ((tx + 1) * _sizeX) / nTilesX;
+
+            if (_coordConverter.getCellOrder() == CoordConverter::ROW_MAJOR) {
+                geometry.push_back(buildRectangleRanges(_bottomLeftX + startX, _bottomLeftY + startY,
+                            endX - startX, endY - startY));
+                continue;
+            }
+
+            std::vector< std::pair<int, int> > tile = buildRectangle(_bottomLeftX + startX, _bottomLeftY + startY,
+                        endX - startX, endY - startY);
+            sortByMemoryIndex(tile);
+            geometry.push_back(toRanges(tile.begin(), tile.end()));
+        }
+    }
+
+    return geometry;
+}
+
 std::vector< std::pair<int, int> > Geometry::buildRectangle(int bottomLeftX, int bottomLeftY,
         unsigned int sizeX, unsigned int sizeY) {
 
@@ -124,27 +197,74 @@ std::vector< std::pair<int, int> > Geometry::buildRectangle(int bottomLeftX, int
     return rect;
 }
 
-std::vector< std::pair<int, int> >
+std::vector<CellRange> Geometry::buildRectangleRanges(int bottomLeftX, int bottomLeftY,
+        unsigned int sizeX, unsigned int sizeY) {
+
+    std::vector<CellRange> rect;
+    if (sizeX == 0)
+        return rect;
+
+    for (unsigned int j = 0; j < sizeY; j++)
+        rect.push_back({bottomLeftX, int(j) + bottomLeftY, sizeX});
+
+    return rect;
+}
+
+std::vector<CellRange>
 Geometry::buildLine(int firstX, int firstY, unsigned int length) {
 
-    std::vector< std::pair<int, int> > line;
+    std::vector<CellRange> line;
     // Return empty vector if first point is not in rectangle
     if (!inRect(firstX, firstY))
         return line;
     int i = firstX;
     int j = firstY;
-    length = std::min<unsigned int>(_topRightX - firstX + _sizeX * (_topRightY - firstY) + 1, length); 
-    for (unsigned int k = 0; k < length; k++) {
-        line.push_back(std::pair<int, int>(i, j));
-        i++;
-        if (i > _topRightX) {
-            i = _bottomLeftX;
-            j++;
-        }
+    length = std::min<unsigned int>(_topRightX - firstX + _sizeX * (_topRightY - firstY) + 1, length);
+    // One range per row crossed by the line.
+    while (length > 0) {
+        unsigned int rowLength = std::min<unsigned int>(_topRightX - i + 1, length);
+        line.push_back({i, j, rowLength});
+        length -= rowLength;
+        i = _bottomLeftX;
+        j++;
     }
     return line;
 }
 
+std::vector<CellRange>
+Geometry::toRanges(std::vector< std::pair<int, int> >::const_iterator first,
+        std::vector< std::pair<int, int> >::const_iterator last) const {
+
+    std::vector<CellRange> ranges;
+    unsigned int lastIndex = 0;
+    for (auto it = first; it != last; ++it) {
+        const unsigned int index = _coordConverter.convert(it->first - _bottomLeftX, it->second - _bottomLeftY);
+        if (!ranges.empty()) {
+            CellRange& range = ranges.back();
+            if (it->second == range.y && it->first == range.x + int(range.length) && index == lastIndex + 1) {
+                ++range.length;
+                lastIndex = index;
+                continue;
+            }
+        }
+        ranges.push_back({it->first, it->second, 1});
+        lastIndex = index;
+    }
+    return ranges;
+}
+
+void Geometry::sortByMemoryIndex(std::vector< std::pair<int, int> >& shape) const {
+
+    if (_coordConverter.getCellOrder() == CoordConverter::ROW_MAJOR)
+        return;
+
+    std::sort(shape.begin(), shape.end(),
+            [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                return _coordConverter.convert(a.first - _bottomLeftX, a.second - _bottomLeftY)
+                    < _coordConverter.convert(b.first - _bottomLeftX, b.second - _bottomLeftY);
+            });
+}
+
 bool Geometry::inRect(int i, int j) {
 
     return (i >= _bottomLeftX && i <= _topRightX
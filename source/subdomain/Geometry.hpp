@@ -8,6 +8,17 @@
  */
 #include <vector>
 #include <string>
+#include "CoordConverter.hpp"
+
+/*!
+ * @brief Cells (x, y), (x + 1, y), ..., (x + length - 1, y) of a row of the
+ * SDD, stored one after the other in memory.
+ */
+struct CellRange {
+    int x;
+    int y;
+    unsigned int length;
+};
 
 /*!
  * @brief Tool providing various splits of SDDs (rectangular shapes) into SDS (any
@@ -24,17 +35,23 @@ class Geometry {
      * @param bottomLeftX Y-coord of bottem-left point of SDD
      * @param sizeX width of SDD
      * @param sizeY height of SDD
+     * @param coordConverter memory layout of the SDD: cells are handed to
+     * the shapes in memory order
      */
     Geometry(int bottomLeftX, int bottomLeftY,
-            unsigned int sizeX, unsigned int sizeY);
+            unsigned int sizeX, unsigned int sizeY,
+            const CoordConverter& coordConverter);
 
     /*!
      * build Geometry according to number and type of shapes
      *
      * @param nShapes number of SDS shapes to create
      * @param geomType type of geometry to build
+     * @param maxShapeSize maximum number of cells in a shape, only used by
+     * the rectangle geometry (0 means no limit)
      */
-    std::vector< std::vector< std::pair<int, int> > > buildGeometry(unsigned int nShapes, std::string geomType);
+    std::vector< std::vector<CellRange> > buildGeometry(unsigned int nShapes, std::string geomType,
+            unsigned int maxShapeSize = 0);
 
     static const std::string LINE;
     static const std::string RECTANGLE;
@@ -49,9 +66,40 @@ class Geometry {
         buildRectangle(int bottomLeftX, int bottomLeftY,
             unsigned int sizeX, unsigned int sizeY);
 
-    std::vector< std::pair<int, int> >
+    std::vector<CellRange>
+        buildRectangleRanges(int bottomLeftX, int bottomLeftY,
+            unsigned int sizeX, unsigned int sizeY);
+
+    std::vector<CellRange>
         buildLine(int firstX, int firstY, unsigned int length);
 
+    /*!
+     * @brief Merges a list of cells into ranges, joining consecutive cells
+     * of a row when they are also consecutive in memory.
+     */
+    std::vector<CellRange>
+        toRanges(std::vector< std::pair<int, int> >::const_iterator first,
+                std::vector< std::pair<int, int> >::const_iterator last) const;
+
+    /*!
+     * @brief Tiles the SDD with balanced rectangles.
+     *
+     * The SDD is cut into at least nShapes tiles, and into more if needed so
+     * that no tile holds more than maxShapeSize cells. Tiles are returned
+     * row of tiles by row of tiles, in a serpentine order, so that two
+     * consecutive tiles always share an edge.
+     *
+     * @param nShapes minimum number of tiles
+     * @param maxShapeSize maximum number of cells in a tile (0 means no limit)
+     */
+    std::vector< std::vector<CellRange> >
+        buildTiles(unsigned int nShapes, unsigned int maxShapeSize);
+
+    /*!
+     * @brief Sorts cells by memory index.
+     */
+    void sortByMemoryIndex(std::vector< std::pair<int, int> >& shape) const;
+
     bool inRect(int i, int j);
 
     int _bottomLeftX;
@@ -60,6 +108,7 @@ class Geometry {
     int _topRightY;
     unsigned int _sizeX;
     unsigned int _sizeY;
+    CoordConverter _coordConverter;
 };
 
 #endif
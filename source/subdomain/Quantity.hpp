@@ -11,10 +11,46 @@
  */
 
 #include <iostream>
-#include <vector>
+#include <memory>
+#include <algorithm>
 
 #include "CoordConverter.hpp"
 
+/*!
+ * Width in bytes of the SIMD registers, sets the number of cells of a block
+ * of the AoSoA layout.
+ */
+#if defined(__AVX512F__)
+#define SIMD_BYTES 64
+#elif defined(__AVX__)
+#define SIMD_BYTES 32
+#else
+#define SIMD_BYTES 16
+#endif
+
+/*!
+ * @brief Typed access to the data of a quantity, to be used by kernels.
+ *
+ * Lanes is 1 for a quantity stored as a plain array (SoA). Otherwise the
+ * quantity belongs to a group stored as AoSoA: blocks of Lanes cells of
+ * each quantity of the group, one after the other, blockStride being the
+ * distance between two blocks of the same quantity.
+ */
+template<typename T, unsigned int Lanes> class QuantityView {
+  public:
+    QuantityView(T* data, size_t blockStride): _data(data), _blockStride(blockStride) {}
+
+    inline T& operator[](size_t k) const {
+        if (Lanes == 1)
+            return _data[k];
+        return _data[(k / Lanes) * _blockStride + k % Lanes];
+    }
+
+  private:
+    T* __restrict _data;
+    size_t _blockStride;
+};
+
 /*!
  * @brief Physical quantity used in numerical schemes.
  *
@@ -38,6 +74,31 @@ template<typename T> class Quantity {
      */
     Quantity(std::string, unsigned int size, const CoordConverter & coordConverter, const T& default_value);
 
+    /*!
+     * @brief Constructor leaving the data uninitialized, so that each
+     * cell can be first touched by the thread computing it.
+     *
+     * @param size : size of the created array
+     * @param coordConverter : tool linking coordinates of a
+     * cell/node to the corresponding memory index
+     */
+    Quantity(std::string, unsigned int size, const CoordConverter & coordConverter);
+
+    /*!
+     * @brief Constructor on memory owned by someone else (see
+     * QuantityArena), left uninitialized.
+     *
+     * @param size : size of the arrays
+     * @param coordConverter : tool linking coordinates of a
+     * cell/node to the corresponding memory index
+     * @param dataLeft, dataRight : the two arrays of data
+     * @param lanes : 1 for a plain array, the size of the blocks for a
+     * member of a AoSoA group (power of 2)
+     * @param blockStride : distance between two blocks of the quantity
+     */
+    Quantity(std::string, unsigned int size, const CoordConverter & coordConverter,
+            T* dataLeft, T* dataRight, unsigned int lanes = 1, size_t blockStride = 1);
+
     /*!
      * @brief Returns desired data available for reading
      * and writing using the SDD's coord converter
@@ -81,8 +142,60 @@ template<typename T> class Quantity {
     void set0(T value, size_t pos);
     void set1(T value, size_t pos);
 
+    /*!
+     * @brief Copies n values from/to the current array, starting at the
+     * cell (coordX, coordY) along its row. One block copy when the row is
+     * contiguous in memory (plain array, row-major order of the cells).
+     */
+    void setRange(const T* values, unsigned int n, int coordX, int coordY);
+    void getRange(T* values, unsigned int n, int coordX, int coordY) const;
+
+    /*!
+     * @brief Raw access to the current (0) and next (1) arrays, to be
+     * stored in __restrict pointers by the kernels. They are swapped by
+     * switchPrevNext.
+     */
+    T* data0() {return _prev;}
+    T* data1() {return _next;}
+    const T* data0() const {return _prev;}
+    const T* data1() const {return _next;}
+
+    /*!
+     * @brief Typed views on the current (0) and next (1) arrays, Lanes
+     * must be getLanes().
+     */
+    template<unsigned int Lanes> QuantityView<T, Lanes> view0() {return QuantityView<T, Lanes>(_prev, _blockStride);}
+    template<unsigned int Lanes> QuantityView<T, Lanes> view1() {return QuantityView<T, Lanes>(_next, _blockStride);}
+
+    unsigned int getLanes() const {return _lanes;}
+
+    unsigned int getSize() const {return _size;}
+
+    /*!
+     * @brief Copies the values of all the cells of the current (n == 0) or
+     * next (n == 1) array from/to values, in the order of their memory
+     * index, for the checkpoints.
+     */
+    void getArray(T* values, unsigned int n) const;
+    void setArray(const T* values, unsigned int n);
+
+    /*!
+     * number of cells of a block when stored as AoSoA
+     */
+    static const unsigned int aosoaLanes = (SIMD_BYTES / sizeof(T) > 0) ? SIMD_BYTES / sizeof(T) : 1;
+
     std::string getName() const {return _name;}
 
+    /*!
+     * @brief position in the arrays of the data of a cell, without branch:
+     * pos for a plain array (no shift, stride 1, empty mask).
+     *
+     * @param pos : memory index of the cell (see CoordConverter)
+     */
+    inline size_t index(size_t pos) const {
+        return (pos >> _laneShift) * _blockStride + (pos & _laneMask);
+    }
+
   private:
 
     /*!
@@ -90,26 +203,39 @@ template<typename T> class Quantity {
      */
     unsigned int _size;
 
+    /*!
+     * layout of the data, see QuantityView
+     */
+    unsigned int _lanes;
+    unsigned int _laneShift;
+    size_t _laneMask;
+    size_t _blockStride;
+
     /*!
      * pointer to the current data (t = t)
      * (read only)
      */
-    std::vector<T> *_prev;
+    T* _prev;
     /*!
      * pointer to the next data (t = t + dt)
      */
-    std::vector<T> *_next;
+    T* _next;
 
     /*!
      * first array of data containing either
      * current or next data
      */
-    std::vector<T> _dataLeft;
+    T* _dataLeft;
     /*!
      * second array of data containing either
      * current or next data
      */
-    std::vector<T> _dataRight;
+    T* _dataRight;
+
+    /*!
+     * storage of both arrays when not given by the owner
+     */
+    std::unique_ptr<T[]> _ownedData;
 
     /*!
      * Copy of coordinates converter owned by the SDD
@@ -124,25 +250,46 @@ template<typename T> class Quantity {
 
 template<typename T>
 Quantity<T>::Quantity(std::string name, unsigned int size,
-        const CoordConverter & coordConverter, const T& default_value):_size(size), _coordConverter(coordConverter)
+        const CoordConverter & coordConverter, const T& default_value):Quantity(name, size, coordConverter)
+{
+    std::fill(_prev, _prev + _size, default_value);
+    std::fill(_next, _next + _size, default_value);
+}
+
+template<typename T>
+Quantity<T>::Quantity(std::string name, unsigned int size,
+        const CoordConverter & coordConverter):Quantity(name, size, coordConverter, nullptr, nullptr)
 {
-    _dataLeft.resize(_size, default_value);
-    _dataRight.resize(_size, default_value);
+    // new T[] does not write the memory: pages are allocated on first touch.
+    _ownedData.reset(new T[2 * _size]);
+    _dataLeft = _ownedData.get();
+    _dataRight = _dataLeft + _size;
 
-    _prev = &_dataLeft;
-    _next = &_dataRight;
+    _prev = _dataLeft;
+    _next = _dataRight;
+}
 
-    _name = name;
+template<typename T>
+Quantity<T>::Quantity(std::string name, unsigned int size,
+        const CoordConverter & coordConverter, T* dataLeft, T* dataRight,
+        unsigned int lanes, size_t blockStride):
+    _size(size), _lanes(lanes), _laneShift(0), _laneMask(lanes - 1), _blockStride(blockStride),
+    _prev(dataLeft), _next(dataRight),
+    _dataLeft(dataLeft), _dataRight(dataRight),
+    _coordConverter(coordConverter), _name(name)
+{
+    while ((1u << _laneShift) < _lanes)
+        ++_laneShift;
 }
 
 template<typename T>
 int Quantity<T>::currentPrev() const {
-    return (_prev == &_dataLeft) ? 0 : 1;
+    return (_prev == _dataLeft) ? 0 : 1;
 }
 
 template<typename T> void Quantity<T>::switchPrevNext()
 {
-    std::vector<T>* _tmp = _prev;
+    T* _tmp = _prev;
     _prev = _next;
     _next = _tmp;
 }
@@ -150,39 +297,86 @@ template<typename T> void Quantity<T>::switchPrevNext()
 template<typename T>
 T Quantity<T>::get(unsigned int n, int coordX, int coordY) const
 {
-    unsigned int i = _coordConverter.convert(coordX, coordY);
-    return (n == 0) ? (*_prev)[i] : (*_next)[i];
+    size_t i = index(_coordConverter.convert(coordX, coordY));
+    return (n == 0) ? _prev[i] : _next[i];
 }
 
 template<typename T> void Quantity<T>::set(T value,
         unsigned int n, int coordX, int coordY) {
 
-    unsigned int i = _coordConverter.convert(coordX, coordY);
+    size_t i = index(_coordConverter.convert(coordX, coordY));
 
     if (n == 0)
-        (*_prev)[i] = value;
+        _prev[i] = value;
     else
-        (*_next)[i] = value;
+        _next[i] = value;
 }
 
 template<typename T>
 T Quantity<T>::get0(size_t pos) const {
-    return (*_prev)[pos];
+    return _prev[index(pos)];
 }
 
 template<typename T>
 T Quantity<T>::get1(size_t pos) const {
-    return (*_next)[pos];
+    return _next[index(pos)];
 }
 
 template<typename T>
 void Quantity<T>::set0(T value, size_t pos) {
-    (*_prev)[pos] = value;
+    _prev[index(pos)] = value;
 }
 
 template<typename T>
 void Quantity<T>::set1(T value, size_t pos) {
-    (*_next)[pos] = value;
+    _next[index(pos)] = value;
+}
+
+template<typename T>
+void Quantity<T>::setRange(const T* values, unsigned int n, int coordX, int coordY) {
+    if (_lanes == 1 && _coordConverter.getCellOrder() == CoordConverter::ROW_MAJOR) {
+        std::copy(values, values + n, _prev + _coordConverter.convert(coordX, coordY));
+        return;
+    }
+
+    for (unsigned int i = 0; i < n; ++i)
+        _prev[index(_coordConverter.convert(coordX + i, coordY))] = values[i];
+}
+
+template<typename T>
+void Quantity<T>::getRange(T* values, unsigned int n, int coordX, int coordY) const {
+    if (_lanes == 1 && _coordConverter.getCellOrder() == CoordConverter::ROW_MAJOR) {
+        const T* row(_prev + _coordConverter.convert(coordX, coordY));
+        std::copy(row, row + n, values);
+        return;
+    }
+
+    for (unsigned int i = 0; i < n; ++i)
+        values[i] = _prev[index(_coordConverter.convert(coordX + i, coordY))];
+}
+
+template<typename T>
+void Quantity<T>::getArray(T* values, unsigned int n) const {
+    const T* data((n == 0) ? _prev : _next);
+    if (_lanes == 1) {
+        std::copy(data, data + _size, values);
+        return;
+    }
+
+    for (size_t pos = 0; pos < _size; ++pos)
+        values[pos] = data[index(pos)];
+}
+
+template<typename T>
+void Quantity<T>::setArray(const T* values, unsigned int n) {
+    T* data((n == 0) ? _prev : _next);
+    if (_lanes == 1) {
+        std::copy(values, values + _size, data);
+        return;
+    }
+
+    for (size_t pos = 0; pos < _size; ++pos)
+        data[index(pos)] = values[pos];
 }
 
 #endif
@@ -0,0 +1,157 @@
+#ifndef QUANTITYARENA_HPP
+#define QUANTITYARENA_HPP
+
+/*!
+ * @file:
+ *
+ * @brief Defines the memory block holding all the quantities of a SDD.
+ */
+
+#include <string>
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "exception/exception.hpp"
+
+/*!
+ * @brief One aligned memory block cut into fields of the same size.
+ *
+ * Each buffer of each quantity of a SDD is a field of the arena. The block
+ * is aligned on a cache line (alignment "64") or on a huge page (alignment
+ * "hugepage"). Fields are spaced by a whole number of pages plus one cache
+ * line, so that the same cell of two fields never lands on the same offset
+ * within a 4K page (4K aliasing).
+ *
+ * The memory is not written by the arena, pages are allocated by the first
+ * thread touching them. It can also be given by the caller (e.g. a MPI shared
+ * window, see SDDistributed::initQuantityArena).
+ */
+template<typename T> class QuantityArena {
+  public:
+
+    /*!
+     * @brief Constructor
+     *
+     * @param nFields : number of fields
+     * @param fieldSize : number of elements of a field
+     * @param alignment : "64" or "hugepage"
+     */
+    QuantityArena(unsigned int nFields, unsigned int fieldSize, const std::string& alignment);
+
+    /*!
+     * @brief Constructor on memory owned by the caller, of getTotalSize bytes
+     * at least and aligned on a cache line.
+     */
+    QuantityArena(unsigned int nFields, unsigned int fieldSize, void* data);
+
+    ~QuantityArena();
+
+    /*!
+     * @brief Number of bytes used by nFields fields of fieldSize elements.
+     */
+    static size_t getTotalSize(unsigned int nFields, unsigned int fieldSize);
+
+    QuantityArena(const QuantityArena&) = delete;
+    QuantityArena& operator=(const QuantityArena&) = delete;
+
+    /*!
+     * @brief Returns the next free field, nullptr if they are all taken.
+     */
+    T* allocateField();
+
+    /*!
+     * @brief Returns count consecutive free fields as one block of at
+     * least nElements elements, nullptr if there is not enough room.
+     */
+    T* allocateFields(unsigned int count, size_t nElements);
+
+    /*!
+     * @brief true if count consecutive free fields hold at least nElements
+     * elements, i.e. if allocateFields would succeed.
+     */
+    bool hasRoom(unsigned int count, size_t nElements) const;
+
+    static const size_t cacheLineSize = 64;
+    static const size_t pageSize = 4096;
+    static const size_t hugePageSize = 2 * 1024 * 1024;
+
+  private:
+
+    /*!
+     * @brief Whole pages plus one cache line between the starts of two fields.
+     */
+    static size_t getStride(unsigned int fieldSize);
+
+    void* _data;
+    size_t _stride;
+    unsigned int _nFields;
+    unsigned int _nAllocated;
+    bool _ownsData;
+};
+
+template<typename T>
+QuantityArena<T>::QuantityArena(unsigned int nFields, unsigned int fieldSize, const std::string& alignment):
+    _data(nullptr), _stride(getStride(fieldSize)), _nFields(nFields), _nAllocated(0), _ownsData(true) {
+
+    size_t align(cacheLineSize);
+    if (alignment == "hugepage")
+        align = hugePageSize;
+    else if (alignment != "64")
+        exitfail("Unknown arena alignment: " + alignment);
+
+    size_t totalSize = ((_stride * nFields + align - 1) / align) * align;
+    if (posix_memalign(&_data, align, totalSize) != 0)
+        throw std::bad_alloc();
+
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (align == hugePageSize)
+        madvise(_data, totalSize, MADV_HUGEPAGE);
+    #endif
+}
+
+template<typename T>
+QuantityArena<T>::QuantityArena(unsigned int nFields, unsigned int fieldSize, void* data):
+    _data(data), _stride(getStride(fieldSize)), _nFields(nFields), _nAllocated(0), _ownsData(false) {
+}
+
+template<typename T>
+QuantityArena<T>::~QuantityArena() {
+    if (_ownsData)
+        free(_data);
+}
+
+template<typename T>
+size_t QuantityArena<T>::getStride(unsigned int fieldSize) {
+    return ((fieldSize * sizeof(T) + pageSize - 1) / pageSize) * pageSize + cacheLineSize;
+}
+
+template<typename T>
+size_t QuantityArena<T>::getTotalSize(unsigned int nFields, unsigned int fieldSize) {
+    return getStride(fieldSize) * nFields;
+}
+
+template<typename T>
+T* QuantityArena<T>::allocateField() {
+    return allocateFields(1, 0);
+}
+
+template<typename T>
+bool QuantityArena<T>::hasRoom(unsigned int count, size_t nElements) const {
+    return _nAllocated + count <= _nFields && nElements * sizeof(T) <= count * _stride;
+}
+
+template<typename T>
+T* QuantityArena<T>::allocateFields(unsigned int count, size_t nElements) {
+    if (!hasRoom(count, nElements))
+        return nullptr;
+
+    char* field = static_cast<char*>(_data) + _stride * _nAllocated;
+    _nAllocated += count;
+    return reinterpret_cast<T*>(field);
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <cassert>
 #include <algorithm>
+#include <thread>
 
 SDDistributed::SDDistributed(unsigned int sizeX,
                              unsigned int sizeY,
@@ -9,24 +10,40 @@ SDDistributed::SDDistributed(unsigned int sizeX,
                              unsigned int boundaryThickness,
                              unsigned int neighbourHood,
                              unsigned int id,
-                             unsigned int nSDD):
-    _coordConverter(sizeX, sizeY, boundaryThickness),
+                             unsigned int nSDD,
+                             std::string cellOrder):
+    _layout("SoA"),
+    _coordConverter(sizeX, sizeY, boundaryThickness, cellOrder),
     _sizeX(sizeX), _sizeY(sizeY),
     _boundaryThickness(boundaryThickness), _neighbourHood(neighbourHood), _id(id),
-    _geometry(0, 0, sizeX, sizeY),
+    _geometry(0, 0, sizeX, sizeY, _coordConverter),
     _BL(BL_X, BL_Y),
-    _nSDD(nSDD)
+    _nSDD(nSDD),
+    _lastRequestArraySize(0),
+    _persistentRequests(false),
+    _derivedDatatypes(false)
     {
 
     assert(boundaryThickness >= 1);
+
+    #ifndef SEQUENTIAL
+    _comm = MPI_COMM_WORLD;
+    _sharedExchange = false;
+    _nodeComm = MPI_COMM_NULL;
+    _sharedWindow = MPI_WIN_NULL;
+    _sharedFlags = nullptr;
+    _sharedEpoch = 0;
+    _cartComm = MPI_COMM_NULL;
+    #endif
 }
 
 SDDistributed::~SDDistributed() {
+    // The buffers are parts of the blocks with the neighbourhood collective.
     for (const auto& it : _bufferSize) {
-        if (_sendBuffer[it.first] != nullptr)
+        if (_sendBlock == nullptr && _sendBuffer[it.first] != nullptr)
             delete[] _sendBuffer[it.first];
 
-        if (_recvBuffer[it.first] != nullptr)
+        if (_recvBlock == nullptr && _recvBuffer[it.first] != nullptr)
             delete[] _recvBuffer[it.first];
     }
 
@@ -35,12 +52,39 @@ SDDistributed::~SDDistributed() {
     _recvBuffer.clear();
 
     #ifndef SEQUENTIAL
+    // The requests and types are released by MPI_Finalize if it was
+    // already called.
+    int finalized(0);
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        for (auto& request: _persistentRequestVector)
+            MPI_Request_free(&request);
+        for (auto& type: _sendTypeVector)
+            MPI_Type_free(&type);
+        for (auto& type: _recvTypeVector)
+            MPI_Type_free(&type);
+    }
+
     delete[] _requestArray;
     delete[] _statusArray;
     #endif
 
     for (auto it = _quantityMap.begin(); it != _quantityMap.end(); ++it)
         delete (it->second);
+
+    #ifndef SEQUENTIAL
+    // The window holds the memory of the quantities.
+    if (!finalized && _sharedWindow != MPI_WIN_NULL) {
+        MPI_Win_unlock_all(_sharedWindow);
+        MPI_Win_free(&_sharedWindow);
+        MPI_Comm_free(&_nodeComm);
+    }
+    #endif
+}
+
+const std::string& SDDistributed::getLayout() const {
+
+    return _layout;
 }
 
 unsigned int SDDistributed::getSizeX() const {
@@ -76,15 +120,19 @@ unsigned int SDDistributed::getNumberBoundaryCells() const {
     return s;
 }
 
-void SDDistributed::buildAllSDS(unsigned int nSDS, std::string geomType) {
+void SDDistributed::buildAllSDS(unsigned int nSDS, std::string geomType, unsigned int maxSDSSize) {
 
-    std::vector< std::vector< std::pair<int, int> > > geom = _geometry.buildGeometry(nSDS, geomType);
+    std::vector< std::vector<CellRange> > geom = _geometry.buildGeometry(nSDS, geomType, maxSDSSize);
     int i = 0;
     for (auto it = geom.begin(); it != geom.end(); ++it) {
         _SDSVector.push_back(SDShared(*it, _coordConverter, i));
         i++;
     }
 
+    // Tiles come in a cache-friendly order, keep it.
+    if (geomType == Geometry::RECTANGLE)
+        return;
+
     /// Shuffling SDS List
     std::random_shuffle(_SDSVector.begin(), _SDSVector.end());
 }
@@ -184,28 +232,31 @@ void SDDistributed::dispatchOverlapCell() {
     if (totalSize == 0)
         exitfail("Zero overlap cells in parallel configuration.");
 
+    // The neighbours on the same node are read from the shared window.
+    totalSize = 0;
+    for (const auto& SDDid: _messageSDDVector)
+        totalSize += _sendIndexVector[SDDid].size();
+
+    if (totalSize == 0)
+        return;
+
     // This is a uniform ditribution of the cells, the boundary cells in each sds does not correspond the geometric position of the cell.
-    size_t s = totalSize / _SDSVector.size();
-    size_t counter = 0;
-    size_t cursor = 0;
+    // Each SDS takes a contiguous part of the sequence, in the order of the
+    // SDSs: the cells of a neighbour are then in the buffer in their order,
+    // whatever the other neighbours and their order in _messageSDDVector
+    // (which differs between the two sides).
+    const size_t nSDS(_SDSVector.size());
 
-    auto SDDit = _neighbourSDDVector.begin();
+    auto SDDit = _messageSDDVector.begin();
     size_t i_vector = 0;
-    for (size_t i = 0; i < totalSize && SDDit != _neighbourSDDVector.end(); ++i) {
+    for (size_t i = 0; i < totalSize && SDDit != _messageSDDVector.end(); ++i) {
 
-        if (counter >= s) {
-            counter = 0;
-            if (++cursor >= _SDSVector.size()) {
-                cursor = 0;
-                s = 1;
-            }
-        }
+        const size_t cursor(i * nSDS / totalSize);
 
         //if (_id == 2)
         //    std::cout << "[" << _id << "] to " << *SDDit << " " << i_vector << " in SDS " << cursor << std::endl;
 
         _SDSVector[cursor].addOverlapCell(*SDDit, _sendIndexVector[*SDDit][i_vector], _recvIndexVector[*SDDit][i_vector]);
-        ++counter;
 
         // Move among the different vectors.
         if (++i_vector >= _sendIndexVector[*SDDit].size()){
@@ -217,7 +268,7 @@ void SDDistributed::dispatchOverlapCell() {
     // Now set the pos in the buffer to start to copy/read the data.
     //std::cout << "[" << _id << "] Total Size: " << totalSize << " in " << _neighbourSDDVector.size() << " neighbour(s)." << std::endl;
     size_t check = 0;
-    for (const auto& SDDid: _neighbourSDDVector) {
+    for (const auto& SDDid: _messageSDDVector) {
         //if (_id == 2)
         //    std::cout << "[" << _id << "] to SDDid: " << SDDid << " current total " << check << std::endl;
 
@@ -275,40 +326,109 @@ Quantity<real>* SDDistributed::getQuantity(std::string name) {
     return _quantityMap[name];
 }
 
+const Quantity<real>* SDDistributed::getQuantity(std::string name) const {
+
+    return _quantityMap.at(name);
+}
+
+std::vector<std::string> SDDistributed::getQuantityNames() const {
+
+    std::vector<std::string> names;
+    for (auto const& it: _quantityMap)
+        names.push_back(it.first);
+    return names;
+}
+
 void SDDistributed::copyOverlapCell() {
     #ifndef SEQUENTIAL
-    _threadPool->start("writeBuffer");
+    if (!_derivedDatatypes)
+        _threadPool->start("writeBuffer");
     #endif
 }
 
 void SDDistributed::sendOverlapCell() {
     #ifndef SEQUENTIAL
+    if (_derivedDatatypes) {
+        // One message per neighbour and quantity, from/to the current array
+        // of the quantity, the quantity being the tag.
+        _lastRequestArraySize = 0;
+        size_t k(0);
+        for (const auto& toSDDid: _neighbourSDDVector) {
+            for (size_t q = 0; q < _exchangedQuantityVector.size(); ++q, ++k) {
+                Quantity<real>& qty(*_exchangedQuantityVector[q]);
+                if (_persistentRequests) {
+                    const int prev(qty.currentPrev());
+                    _requestArray[_lastRequestArraySize] = _persistentRequestVector[2 * _lastRequestArraySize + prev];
+                    ++_lastRequestArraySize;
+                    _requestArray[_lastRequestArraySize] = _persistentRequestVector[2 * _lastRequestArraySize + prev];
+                    ++_lastRequestArraySize;
+                    continue;
+                }
+
+                MPI_Irecv(qty.data0(), 1, _recvTypeVector[k], toSDDid, q,
+                          _comm, &_requestArray[_lastRequestArraySize++]);
+
+                MPI_Isend(qty.data0(), 1, _sendTypeVector[k], toSDDid, q,
+                          _comm, &_requestArray[_lastRequestArraySize++]);
+            }
+        }
+
+        if (_persistentRequests)
+            MPI_Startall(_lastRequestArraySize, _requestArray);
+        return;
+    }
+
+    // The cells of this SDD are ready for the neighbours on the node.
+    if (_sharedExchange) {
+        ++_sharedEpoch;
+        MPI_Win_sync(_sharedWindow);
+        _sharedFlags[0] = _sharedEpoch;
+        MPI_Win_sync(_sharedWindow);
+    }
+
+    if (_persistentRequests) {
+        MPI_Startall(_lastRequestArraySize, _requestArray);
+        return;
+    }
+
+    if (_cartComm != MPI_COMM_NULL) {
+        MPI_Ineighbor_alltoallv(_sendBlock.get(), _sendCounts.data(), _sendDispls.data(), MPI_REALTYPE,
+                                _recvBlock.get(), _recvCounts.data(), _recvDispls.data(), MPI_REALTYPE,
+                                _cartComm, &_requestArray[0]);
+        _lastRequestArraySize = 1;
+        return;
+    }
+
     _lastRequestArraySize = 0;
-    for (const auto& toSDDid: _neighbourSDDVector) {
+    for (const auto& toSDDid: _messageSDDVector) {
         real* dataToSend = _sendBuffer[toSDDid];
         real* dataToRecv = _recvBuffer[toSDDid];
         size_t bufferSize = _bufferSize[toSDDid];
 
         MPI_Irecv(dataToRecv, bufferSize,
                   MPI_REALTYPE, toSDDid, toSDDid * _nSDD + _id,
-                  MPI_COMM_WORLD, &_requestArray[_lastRequestArraySize++]);
+                  _comm, &_requestArray[_lastRequestArraySize++]);
 
         MPI_Isend(dataToSend, bufferSize,
                   MPI_REALTYPE, toSDDid, _id * _nSDD + toSDDid,
-                  MPI_COMM_WORLD, &_requestArray[_lastRequestArraySize++]);
+                  _comm, &_requestArray[_lastRequestArraySize++]);
     }
     #endif
 }
 
 void SDDistributed::waitOverlapCell() {
     #ifndef SEQUENTIAL
+    if (_sharedExchange)
+        copySharedOverlapCell();
+
     MPI_Waitall(_lastRequestArraySize, _requestArray, _statusArray);
     #endif
 }
 
 void SDDistributed::parseOverlapCell() {
     #ifndef SEQUENTIAL
-    _threadPool->start("readBuffer");
+    if (!_derivedDatatypes)
+        _threadPool->start("readBuffer");
     #endif
 
     // Special case: parsing data for periodic boundary condition with itself.
@@ -322,16 +442,434 @@ void SDDistributed::parseOverlapCell() {
 }
 
 
+#ifndef SEQUENTIAL
+namespace {
+
+    // Cells of a quantity as a datatype on its arrays: the strips of a
+    // rectangular SDD are regularly spaced (vector), any other map is
+    // indexed.
+    MPI_Datatype buildCellType(const Quantity<real>& qty, const std::vector<size_t>& cells) {
+
+        std::vector<int> displacements;
+        displacements.reserve(cells.size());
+        for (const auto& pos: cells)
+            displacements.push_back(qty.index(pos));
+
+        const int count(displacements.size());
+        const int stride(count > 1 ? displacements[1] - displacements[0] : 1);
+        bool regular(true);
+        for (int i = 1; i < count && regular; ++i)
+            regular = (displacements[i] - displacements[i - 1] == stride);
+
+        MPI_Datatype type;
+        if (regular) {
+            MPI_Datatype vector;
+            MPI_Type_vector(count, 1, stride, MPI_REALTYPE, &vector);
+            MPI_Aint start(displacements[0] * sizeof(real));
+            MPI_Type_create_hindexed_block(1, 1, &start, vector, &type);
+            MPI_Type_free(&vector);
+        } else {
+            MPI_Type_create_indexed_block(count, 1, displacements.data(), MPI_REALTYPE, &type);
+        }
+
+        MPI_Type_commit(&type);
+        return type;
+    }
+}
+#endif
+
+void SDDistributed::buildOverlapDatatypes() {
+    #ifndef SEQUENTIAL
+    // Same order on all the SDDs: the map is sorted by name.
+    _exchangedQuantityVector.clear();
+    for (const auto& it: _quantityMap)
+        _exchangedQuantityVector.push_back(it.second);
+
+    for (const auto& toSDDid: _neighbourSDDVector) {
+        for (size_t q = 0; q < _exchangedQuantityVector.size(); ++q) {
+            Quantity<real>* qty(_exchangedQuantityVector[q]);
+            _sendTypeVector.push_back(buildCellType(*qty, _sendIndexVector[toSDDid]));
+            _recvTypeVector.push_back(buildCellType(*qty, _recvIndexVector[toSDDid]));
+
+            if (!_persistentRequests)
+                continue;
+
+            // The two arrays of the quantity, by value of currentPrev().
+            real* data[2];
+            data[qty->currentPrev()] = qty->data0();
+            data[1 - qty->currentPrev()] = qty->data1();
+
+            // Stored in the order of _requestArray (see sendOverlapCell).
+            const int tag(q);
+            for (int prev = 0; prev < 2; ++prev) {
+                MPI_Request request;
+                MPI_Recv_init(data[prev], 1, _recvTypeVector.back(), toSDDid, tag, _comm, &request);
+                _persistentRequestVector.push_back(request);
+            }
+            for (int prev = 0; prev < 2; ++prev) {
+                MPI_Request request;
+                MPI_Send_init(data[prev], 1, _sendTypeVector.back(), toSDDid, tag, _comm, &request);
+                _persistentRequestVector.push_back(request);
+            }
+        }
+    }
+    #endif
+}
+
+#ifndef SEQUENTIAL
+void SDDistributed::setComm(MPI_Comm comm, bool cartesian) {
+    _comm = comm;
+    if (cartesian)
+        _cartComm = comm;
+}
+#endif
+
+void SDDistributed::buildNeighbourExchange() {
+    #ifndef SEQUENTIAL
+    // SDDs in the directions of the topology, whose ranks are their ids:
+    // -y, +y, -x, +x.
+    const int nDirections(4);
+    int neighbours[nDirections];
+    MPI_Cart_shift(_cartComm, 0, 1, &neighbours[0], &neighbours[1]);
+    MPI_Cart_shift(_cartComm, 1, 1, &neighbours[2], &neighbours[3]);
+
+    _sendCounts.assign(nDirections, 0);
+    _sendDispls.assign(nDirections, 0);
+    _recvCounts.assign(nDirections, 0);
+    _recvDispls.assign(nDirections, 0);
+
+    // A neighbour seen in several directions (periodic grid of two SDDs
+    // along an axis) is sent its buffer in each of them, the libraries
+    // don't agree on how such messages are matched. The first one is
+    // received in the buffer of the neighbour, the others after the buffers.
+    size_t recvBlockSize(0), spareSize(0);
+    for (const auto& SDDid: _neighbourSDDVector) {
+        recvBlockSize += _bufferSize[SDDid];
+        const size_t nSeen(std::count(neighbours, neighbours + nDirections, int(SDDid)));
+        if (nSeen == 0)
+            exitfail("The neighbourhood collective needs the neighbours of the Cartesian topology.");
+        spareSize += (nSeen - 1) * _bufferSize[SDDid];
+    }
+
+    if (spareSize > 0) {
+        real* recvBlock(new real[recvBlockSize + spareSize]());
+        for (const auto& SDDid: _neighbourSDDVector)
+            _recvBuffer[SDDid] = recvBlock + (_recvBuffer[SDDid] - _recvBlock.get());
+        _recvBlock.reset(recvBlock);
+    }
+
+    size_t sparePos(recvBlockSize);
+    for (int d = 0; d < nDirections; ++d) {
+        if (neighbours[d] < 0)
+            continue;
+
+        const auto it(_bufferSize.find(neighbours[d]));
+        if (it == _bufferSize.end())
+            continue;
+
+        const unsigned int SDDid(neighbours[d]);
+        _sendCounts[d] = it->second;
+        _sendDispls[d] = _sendBuffer[SDDid] - _sendBlock.get();
+        _recvCounts[d] = it->second;
+        if (std::find(neighbours, neighbours + d, neighbours[d]) == neighbours + d) {
+            _recvDispls[d] = _recvBuffer[SDDid] - _recvBlock.get();
+        } else {
+            _recvDispls[d] = sparePos;
+            sparePos += it->second;
+        }
+    }
+
+    _lastRequestArraySize = 0;
+    #if MPI_VERSION >= 4
+    if (_persistentRequests) {
+        MPI_Request request;
+        MPI_Neighbor_alltoallv_init(_sendBlock.get(), _sendCounts.data(), _sendDispls.data(), MPI_REALTYPE,
+                                    _recvBlock.get(), _recvCounts.data(), _recvDispls.data(), MPI_REALTYPE,
+                                    _cartComm, MPI_INFO_NULL, &request);
+        _persistentRequestVector.push_back(request);
+        _requestArray[_lastRequestArraySize++] = request;
+    }
+    #else
+    // No persistent collectives before MPI 4.
+    _persistentRequests = false;
+    #endif
+    #endif
+}
+
+void SDDistributed::buildSharedExchange() {
+    #ifndef SEQUENTIAL
+    int nodeSize(0), nodeRank(0);
+    MPI_Comm_size(_nodeComm, &nodeSize);
+    MPI_Comm_rank(_nodeComm, &nodeRank);
+    std::vector<int> nodeSDD(nodeSize);
+    int id(_id);
+    MPI_Allgather(&id, 1, MPI_INT, nodeSDD.data(), 1, MPI_INT, _nodeComm);
+
+    // Where the quantities are in the segment of this SDD.
+    MPI_Aint segmentSize;
+    int dispUnit;
+    char* segment(nullptr);
+    MPI_Win_shared_query(_sharedWindow, nodeRank, &segmentSize, &dispUnit, &segment);
+
+    std::vector<long> dataOffsets;
+    for (const auto& it: _quantityMap) {
+        const Quantity<real>& qty(*it.second);
+        const real* data[2];
+        data[qty.currentPrev()] = qty.data0();
+        data[1 - qty.currentPrev()] = qty.data1();
+        for (int prev = 0; prev < 2; ++prev) {
+            const char* address(reinterpret_cast<const char*>(data[prev]));
+            if (address < segment || address >= segment + segmentSize)
+                exitfail("Quantity " + it.first + " is not in the shared window.");
+            dataOffsets.push_back(address - segment);
+        }
+    }
+
+    // Neighbours on the node send where to read their arrays and their cells.
+    const size_t nQuantities(_quantityMap.size());
+    _messageSDDVector.clear();
+    _sharedNeighbourVector.clear();
+    std::vector< std::vector<long> > sendOffsets, recvOffsets;
+    std::vector<const char*> neighbourSegments;
+    for (const auto& SDDid: _neighbourSDDVector) {
+        auto nodeIt = std::find(nodeSDD.begin(), nodeSDD.end(), (int)SDDid);
+        if (nodeIt == nodeSDD.end()) {
+            _messageSDDVector.push_back(SDDid);
+            continue;
+        }
+
+        SharedNeighbour neighbour;
+        neighbour.id = SDDid;
+        char* there(nullptr);
+        MPI_Win_shared_query(_sharedWindow, nodeIt - nodeSDD.begin(), &segmentSize, &dispUnit, &there);
+        neighbour.flags = reinterpret_cast<volatile long*>(there);
+        neighbourSegments.push_back(there);
+        neighbour.data[0].resize(nQuantities);
+        neighbour.data[1].resize(nQuantities);
+        _sharedNeighbourVector.push_back(neighbour);
+
+        std::vector<long> offsets(dataOffsets);
+        for (const auto& it: _quantityMap) {
+            for (const auto& pos: _sendIndexVector[SDDid])
+                offsets.push_back(it.second->index(pos));
+        }
+        sendOffsets.push_back(offsets);
+        recvOffsets.push_back(std::vector<long>(2 * nQuantities + nQuantities * _recvIndexVector[SDDid].size()));
+    }
+
+    std::vector<MPI_Request> requests;
+    for (size_t n = 0; n < _sharedNeighbourVector.size(); ++n) {
+        requests.resize(requests.size() + 2);
+        MPI_Irecv(recvOffsets[n].data(), recvOffsets[n].size(), MPI_LONG, _sharedNeighbourVector[n].id, 0, _comm, &requests[requests.size() - 2]);
+        MPI_Isend(sendOffsets[n].data(), sendOffsets[n].size(), MPI_LONG, _sharedNeighbourVector[n].id, 0, _comm, &requests[requests.size() - 1]);
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    for (size_t n = 0; n < _sharedNeighbourVector.size(); ++n) {
+        SharedNeighbour& neighbour(_sharedNeighbourVector[n]);
+        const char* there(neighbourSegments[n]);
+        for (size_t q = 0; q < nQuantities; ++q) {
+            neighbour.data[0][q] = reinterpret_cast<const real*>(there + recvOffsets[n][2 * q]);
+            neighbour.data[1][q] = reinterpret_cast<const real*>(there + recvOffsets[n][2 * q + 1]);
+        }
+        neighbour.offsets.assign(recvOffsets[n].begin() + 2 * nQuantities, recvOffsets[n].end());
+    }
+    #endif
+}
+
+void SDDistributed::copySharedOverlapCell() {
+    #ifndef SEQUENTIAL
+    for (const auto& neighbour: _sharedNeighbourVector) {
+        while (neighbour.flags[0] < _sharedEpoch) {
+            std::this_thread::yield();
+            MPI_Win_sync(_sharedWindow);
+        }
+
+        const std::vector<size_t>& recvIndex(_recvIndexVector[neighbour.id]);
+        const size_t nCells(recvIndex.size());
+        size_t q(0);
+        for (const auto& it: _quantityMap) {
+            Quantity<real>& qty(*it.second);
+            const real* there(neighbour.data[qty.currentPrev()][q]);
+            const long* offsets(&neighbour.offsets[q * nCells]);
+            for (size_t k = 0; k < nCells; ++k)
+                qty.set0(there[offsets[k]], recvIndex[k]);
+            ++q;
+        }
+    }
+
+    // The cells of this SDD can be modified once all the neighbours have
+    // copied them.
+    MPI_Win_sync(_sharedWindow);
+    _sharedFlags[1] = _sharedEpoch;
+    MPI_Win_sync(_sharedWindow);
+    for (const auto& neighbour: _sharedNeighbourVector) {
+        while (neighbour.flags[1] < _sharedEpoch) {
+            std::this_thread::yield();
+            MPI_Win_sync(_sharedWindow);
+        }
+    }
+    #endif
+}
 
 void SDDistributed::execEquation(std::string eqName) {
 
     _threadPool->start(eqName);
 }
 
-void SDDistributed::initThreadPool(unsigned int nThreads, unsigned int nCommonSDS) {
+void SDDistributed::addSplitEquation(std::string eqName, eqType eqFunc) {
+
+    assert(_borderSDS.size() == _SDSVector.size());
+    for (size_t i = 0; i < _SDSVector.size(); ++i) {
+        const std::string taskName(eqName + (_borderSDS[i] ? " border" : " interior"));
+        _threadPool->addTask(taskName, std::bind(&SDShared::execEquation, _SDSVector[i], eqFunc, _quantityMap));
+    }
+}
+
+void SDDistributed::execInteriorEquation(std::string eqName) {
+
+    _threadPool->start(eqName + " interior");
+}
+
+void SDDistributed::execBorderEquation(std::string eqName) {
+
+    _threadPool->start(eqName + " border");
+}
+
+void SDDistributed::buildHaloSDS(unsigned int nLayers) {
+
+    if (nLayers >= _boundaryThickness)
+        exitfail("The ghost layers must be thinner than the boundary.");
+
+    const int sizeX = _sizeX;
+    const int sizeY = _sizeY;
+    unsigned int id(_SDSVector.size());
+    _haloSDSVector.clear();
+    for (int l = 1; l <= int(nLayers); ++l) {
+        // The ring at distance l, cut in rows of consecutive overlap cells:
+        // cells of the domain boundary are not computed.
+        std::vector<CellRange> ranges;
+        auto addCell = [&](int x, int y) {
+            if (_MPIRecv_map.find(std::make_pair(x, y)) == _MPIRecv_map.end())
+                return;
+            if (!ranges.empty() && ranges.back().y == y && ranges.back().x + int(ranges.back().length) == x)
+                ++ranges.back().length;
+            else
+                ranges.push_back(CellRange{x, y, 1});
+        };
+
+        for (int x = -l; x < sizeX + l; ++x)
+            addCell(x, -l);
+        for (int y = 1 - l; y < sizeY + l - 1; ++y) {
+            addCell(-l, y);
+            addCell(sizeX + l - 1, y);
+        }
+        for (int x = -l; x < sizeX + l; ++x)
+            addCell(x, sizeY + l - 1);
+
+        _haloSDSVector.push_back(SDShared(ranges, _coordConverter, id++));
+    }
+}
+
+void SDDistributed::addHaloEquation(std::string eqName, eqType eqFunc) {
+
+    // The task of width w computes the layers 1 to w.
+    for (size_t width = 1; width <= _haloSDSVector.size(); ++width) {
+        for (size_t l = 0; l < width; ++l)
+            _threadPool->addTask(eqName + " halo " + std::to_string(width), std::bind(&SDShared::execEquation, _haloSDSVector[l], eqFunc, _quantityMap));
+    }
+}
+
+void SDDistributed::execHaloEquation(std::string eqName, unsigned int width) {
+
+    if (width == 0)
+        return;
+
+    assert(width <= _haloSDSVector.size());
+    _threadPool->start(eqName + " halo " + std::to_string(width));
+}
+
+void SDDistributed::classifySDS() {
+
+    // Cells written by the communications.
+    std::vector<bool> overlapCell(_coordConverter.getSize(), false);
+    for (const auto& it: _recvIndexVector) {
+        for (const auto& index: it.second)
+            overlapCell[index] = true;
+    }
+    for (const auto& it: _selfIndexMap)
+        overlapCell[it.first] = true;
+
+    // Overlap cells are outside of the SDD, only the cells close to its
+    // edges can reach them.
+    const int b = _boundaryThickness;
+    const int sizeX = _sizeX;
+    const int sizeY = _sizeY;
+    _borderSDS.assign(_SDSVector.size(), false);
+    for (size_t s = 0; s < _SDSVector.size(); ++s) {
+        for (const auto& range: _SDSVector[s].getRanges()) {
+            const int j = range.y;
+            const int xEnd = range.x + range.length;
+            if (j >= b && j < sizeY - b && range.x >= b && xEnd <= sizeX - b)
+                continue;
+
+            for (int i = range.x; i < xEnd && !_borderSDS[s]; ++i) {
+                for (int dj = -b; dj <= b && !_borderSDS[s]; ++dj) {
+                    for (int di = -b; di <= b; ++di) {
+                        if (overlapCell[_coordConverter.convert(i + di, j + dj)]) {
+                            _borderSDS[s] = true;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (_borderSDS[s])
+                break;
+        }
+    }
+}
+
+void SDDistributed::initQuantityArena(unsigned int nQuantities, const std::string& alignment, bool shared) {
+
+    assert(_quantityMap.empty());
+    #ifndef SEQUENTIAL
+    if (shared) {
+        // The flags of the exchange, then the quantities, on separate pages.
+        const size_t flagsSize(QuantityArena<real>::pageSize);
+        const size_t size(flagsSize + QuantityArena<real>::getTotalSize(2 * nQuantities, _coordConverter.getSize()));
+
+        MPI_Comm_split_type(_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &_nodeComm);
+
+        // Segments on their own pages, close to their SDD.
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        char* segment(nullptr);
+        MPI_Win_allocate_shared(size, 1, info, _nodeComm, &segment, &_sharedWindow);
+        MPI_Info_free(&info);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, _sharedWindow);
+
+        _sharedFlags = reinterpret_cast<volatile long*>(segment);
+        _sharedFlags[0] = 0;
+        _sharedFlags[1] = 0;
+        _sharedExchange = true;
+
+        _quantityArena = std::unique_ptr< QuantityArena<real> >(new QuantityArena<real>(2 * nQuantities, _coordConverter.getSize(), segment + flagsSize));
+        return;
+    }
+    #else
+    (void) shared;
+    #endif
+
+    _quantityArena = std::unique_ptr< QuantityArena<real> >(new QuantityArena<real>(2 * nQuantities, _coordConverter.getSize(), alignment));
+}
+
+void SDDistributed::initThreadPool(unsigned int nThreads,
+        const std::string& waitPolicy, const std::string& affinity) {
 
     assert(nThreads > 0);
-    _threadPool = std::unique_ptr<ThreadPool>(new ThreadPool(std::forward<unsigned int>(nThreads), std::forward<unsigned int>(nCommonSDS)));
+    _threadPool = std::unique_ptr<ThreadPool>(new ThreadPool(std::forward<unsigned int>(nThreads), waitPolicy, affinity));
 }
 
 void SDDistributed::setValue(std::string quantityName,
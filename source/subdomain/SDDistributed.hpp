@@ -17,6 +17,7 @@
 
 #include "SDShared.hpp"
 #include "Quantity.hpp"
+#include "QuantityArena.hpp"
 #include "Geometry.hpp"
 #include "number/number.hpp"
 #include "threadpool/threadpool.hpp"
@@ -80,13 +81,15 @@ class SDDistributed {
      * on the X-axis
      * @param sizeY number of cells of subdomain
      * on the Y-axis
+     * @param cellOrder order of the cells in memory, see CoordConverter
      */
     SDDistributed(unsigned int sizeX, unsigned int sizeY,
             int BL_X, int BL_Y,
             unsigned int boundaryThickness,
             unsigned int neighbourHood,
             unsigned int id,
-            unsigned int nSDD);
+            unsigned int nSDD,
+            std::string cellOrder = CoordConverter::ROW_MAJOR);
     /*!
      * @brief Destructor
      */
@@ -106,6 +109,12 @@ class SDDistributed {
      * @param name name of the quantity to get
      */
     Quantity<real>* getQuantity(std::string name);
+    const Quantity<real>* getQuantity(std::string name) const;
+
+    /*!
+     * @brief Gets the names of the quantities, in alphabetical order.
+     */
+    std::vector<std::string> getQuantityNames() const;
 
     /*!
      * @brief Gets all SDS on SDD for a read-only
@@ -177,9 +186,28 @@ class SDDistributed {
     /*!
      * @brief Builds map of cells to send from this SDD to other SDDs.
      *
-     * @param domain parent domain of the SDD
+     * @param persistentRequests : create the requests of the overlap cells
+     * exchange once (MPI_Send_init/MPI_Recv_init), sendOverlapCell then only
+     * starts them
+     * @param derivedDatatypes : send the overlap cells straight from the
+     * quantities, described by MPI datatypes, instead of packing them in
+     * buffers
      */
-    void buildSendMap();
+    void buildSendMap(bool persistentRequests, bool derivedDatatypes);
+
+    #ifndef SEQUENTIAL
+    /*!
+     * @brief Sets the communicator of the SDDs, MPI_COMM_WORLD by default.
+     * To be called before building the exchanges.
+     *
+     * @param comm communicator in which the rank of a process is its SDD id,
+     * owned by the caller
+     * @param cartesian comm is the Cartesian topology of the grid of SDDs:
+     * the overlap cells are then exchanged by one neighbourhood collective
+     * on it (see buildSendMap)
+     */
+    void setComm(MPI_Comm comm, bool cartesian);
+    #endif
     /*!
      * @brief Builds map between coords on SDD and "real cell" on neighbour SDD /
      * boundary side
@@ -197,9 +225,43 @@ class SDDistributed {
      *
      * @param name name of the quantity to add, used as reference when getting
      * and setting a value, or when getting the whole quantity data
+     *
+     * Does nothing if the quantity already exists (e.g. added by
+     * addQuantityGroup).
      */
     template<typename T> void addQuantity(std::string name, const T& default_value);
 
+    /*!
+     * @brief Adds physical quantities read and written together by the
+     * scheme.
+     *
+     * @param names names of the quantities of the group
+     * @param layout "SoA": one array per quantity, as addQuantity does;
+     * "AoSoA": one array for the group, made of blocks of
+     * Quantity::aosoaLanes cells of each quantity (see QuantityView)
+     */
+    template<typename T> void addQuantityGroup(const std::vector<std::string>& names, const T& default_value,
+            const std::string& layout);
+
+    /*!
+     * @brief Returns the layout of the quantities: "AoSoA" if a group has
+     * been stored as AoSoA, "SoA" otherwise.
+     */
+    const std::string& getLayout() const;
+
+    /*!
+     * @brief Reserves one memory block for the quantities to be added
+     * (see QuantityArena). Quantities added beyond nQuantities get their
+     * own memory.
+     *
+     * @param nQuantities number of quantities to hold
+     * @param alignment alignment of the block: "64" or "hugepage"
+     * @param shared the block is the segment of the SDD in a MPI shared
+     * window of the SDDs of the node (alignment is then ignored): the SDDs
+     * of the same node read their overlap cells from each other's memory
+     */
+    void initQuantityArena(unsigned int nQuantities, const std::string& alignment, bool shared = false);
+
     /*!
      * @brief Build subdomains on shared memory based on
      * geometry type
@@ -207,8 +269,10 @@ class SDDistributed {
      * @param nSDS number of subdomains to be built
      * @param geomType geometry type of subdomain (see
      * the Geometry class for possible values)
+     * @param maxSDSSize maximum number of cells in a SDS (rectangle
+     * geometry only, 0 means no limit)
      */
-    void buildAllSDS(unsigned int nSDS, std::string geomType);
+    void buildAllSDS(unsigned int nSDS, std::string geomType, unsigned int maxSDSSize = 0);
 
     /*!
     * @brief Dispatch the boundary cells among the sds.
@@ -244,20 +308,86 @@ class SDDistributed {
      */
     void execEquation(std::string eqName);
 
+    /*!
+     * @brief Adds an equation computed in two parts: on the interior SDSs,
+     * which do not read any overlap cell, and on the border SDSs (see
+     * classifySDS).
+     */
+    void addSplitEquation(std::string eqName, eqType eqFunc);
+    void execInteriorEquation(std::string eqName);
+    void execBorderEquation(std::string eqName);
+
+    /*!
+     * @brief Finds the SDSs having a cell close to an overlap cell (within
+     * the boundary thickness), they must wait for the communications.
+     */
+    void classifySDS();
+
+    /*!
+     * @brief Builds the ghost layers of the deep halo: the overlap cells at
+     * distance 1 to nLayers of the SDD (Chebyshev distance), one SDS per
+     * layer. Equations added by addHaloEquation compute them redundantly
+     * with the SDDs owning them, between two exchanges.
+     */
+    void buildHaloSDS(unsigned int nLayers);
+    void addHaloEquation(std::string eqName, eqType eqFunc);
+
+    /*!
+     * @brief Computes the equation on the ghost layers 1 to width, nothing
+     * if width is 0.
+     */
+    void execHaloEquation(std::string eqName, unsigned int width);
+
     /*!
      * @brief Builds thread pool given an amount of threads to build.
      *
      * @param nThreads number of threads to build
-     * @param nCommonSDS number of work to share among the threads
+     * @param waitPolicy how idle threads wait: spin, backoff or park
+     * @param affinity how threads are pinned to cores: none, compact,
+     * scatter or a list of cores
      */
-    void initThreadPool(unsigned int nThreads, unsigned int nCommonSDS);
+    void initThreadPool(unsigned int nThreads,
+            const std::string& waitPolicy = "spin",
+            const std::string& affinity = "none");
 
   private:
 
+    /*!
+     * @brief Writes the default value in all the cells of a new quantity.
+     */
+    template<typename T> void initQuantity(Quantity<T>* quantity, const T& default_value);
+
     // Multithreaded read/write buffer for SDD communication.
     void writeBuffer(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
     void readBuffer(const SDShared& sds, const std::map< std::string, Quantity<real>* >& quantityMap);
 
+    /*!
+     * @brief Builds the datatypes (and the persistent requests) of the
+     * exchange of the overlap cells without buffers: one message per
+     * neighbour and quantity.
+     */
+    void buildOverlapDatatypes();
+
+    /*!
+     * @brief Finds the neighbours on the same node and where to read their
+     * cells in the shared window, the other neighbours are left in
+     * _messageSDDVector.
+     */
+    void buildSharedExchange();
+
+    /*!
+     * @brief Counts and displacements in the blocks of buffers of the
+     * neighbourhood collective, for each direction of the topology.
+     */
+    void buildNeighbourExchange();
+
+    /*!
+     * @brief Copies the overlap cells of the neighbours on the same node:
+     * waits for them to be ready, copies, then waits for all of them to be
+     * done with the cells of this SDD.
+     */
+    void copySharedOverlapCell();
+
     // Attributes
     /*!
      * map storing physical quantities in correspondance
@@ -267,11 +397,37 @@ class SDDistributed {
 
     std::map< std::string, Quantity<real>* > _quantityMap;
 
+    /*!
+     * memory of the quantities, two fields per quantity
+     */
+    std::unique_ptr< QuantityArena<real> > _quantityArena;
+
+    /*!
+     * memory of the AoSoA groups not held by the arena
+     */
+    std::vector< std::unique_ptr<real[]> > _groupData;
+
+    /*!
+     * layout of the quantities, see getLayout
+     */
+    std::string _layout;
+
     /*!
      * array of all subdomains of the SDD
      */
     std::vector<SDShared> _SDSVector;
 
+    /*!
+     * true for the SDSs reading overlap cells (see classifySDS)
+     */
+    std::vector<bool> _borderSDS;
+
+    /*!
+     * ghost layers of the deep halo, the layer l + 1 at index l (see
+     * buildHaloSDS)
+     */
+    std::vector<SDShared> _haloSDSVector;
+
     /*!
      * tool specific to a subdomain to convert 2D coordinates
      * to memory indices of data
@@ -342,6 +498,86 @@ class SDDistributed {
     MPI_Status* _statusArray;
     #endif
     size_t _lastRequestArraySize;
+    bool _persistentRequests;
+    bool _derivedDatatypes;
+
+    #ifndef SEQUENTIAL
+    /*!
+     * persistent requests, with derivedDatatypes one for each of the two
+     * arrays of the quantity: request r of _requestArray is 2 * r or
+     * 2 * r + 1 depending on currentPrev()
+     */
+    std::vector<MPI_Request> _persistentRequestVector;
+    /*!
+     * with derivedDatatypes, cells to send and receive in the arrays of a
+     * quantity, for each neighbour then each quantity
+     */
+    std::vector<MPI_Datatype> _sendTypeVector;
+    std::vector<MPI_Datatype> _recvTypeVector;
+    std::vector<Quantity<real>*> _exchangedQuantityVector;
+    #endif
+
+    /*!
+     * neighbours exchanging overlap cells through messages (all of them
+     * but the ones of the same node with a shared window)
+     */
+    std::vector<unsigned int> _messageSDDVector;
+
+    #ifndef SEQUENTIAL
+    /*!
+     * @brief A neighbour on the same node, read in the shared window.
+     */
+    struct SharedNeighbour {
+        unsigned int id;
+        /*!
+         * ready and done epochs of the neighbour
+         */
+        volatile long* flags;
+        /*!
+         * for each quantity, its array which is current when currentPrev()
+         * is 0 (resp. 1): all the SDDs switch their quantities together
+         */
+        std::vector<const real*> data[2];
+        /*!
+         * for each quantity, the positions in its arrays of the cells
+         * matching _recvIndexVector[id]
+         */
+        std::vector<long> offsets;
+    };
+
+    /*!
+     * communicator of the SDDs, the rank of a process is its SDD id
+     */
+    MPI_Comm _comm;
+
+    bool _sharedExchange;
+    MPI_Comm _nodeComm;
+    MPI_Win _sharedWindow;
+    volatile long* _sharedFlags;
+    long _sharedEpoch;
+    std::vector<SharedNeighbour> _sharedNeighbourVector;
+
+    /*!
+     * Cartesian communicator of the SDDs (_comm), MPI_COMM_NULL unless the
+     * overlap cells are exchanged by a neighbourhood collective
+     */
+    MPI_Comm _cartComm;
+    /*!
+     * counts and displacements of the collective in the blocks, by
+     * direction of the topology: -y, +y, -x, +x
+     */
+    std::vector<int> _sendCounts;
+    std::vector<int> _sendDispls;
+    std::vector<int> _recvCounts;
+    std::vector<int> _recvDispls;
+    #endif
+
+    /*!
+     * with the neighbourhood collective, the buffers of all the neighbours
+     * one after the other
+     */
+    std::unique_ptr<real[]> _sendBlock;
+    std::unique_ptr<real[]> _recvBlock;
 
     // Speed-up structures.
     std::unordered_map<unsigned int, std::vector<size_t> > _sendIndexVector;
@@ -350,7 +586,122 @@ class SDDistributed {
 };
 
 template<typename T> void SDDistributed::addQuantity(std::string name, const T& default_value) {
-    _quantityMap[name] = new Quantity<T>(name, (_sizeX + 2 * _boundaryThickness) * (_sizeY + 2 * _boundaryThickness), _coordConverter, default_value);
+
+    if (_quantityMap.find(name) != _quantityMap.end())
+        return;
+
+    // Both arrays in the arena, or both on the heap.
+    Quantity<T>* quantity(nullptr);
+    if (_quantityArena != nullptr && _quantityArena->hasRoom(2, 0)) {
+        T* dataLeft(_quantityArena->allocateField());
+        T* dataRight(_quantityArena->allocateField());
+        quantity = new Quantity<T>(name, _coordConverter.getSize(), _coordConverter, dataLeft, dataRight);
+    } else {
+        quantity = new Quantity<T>(name, _coordConverter.getSize(), _coordConverter);
+    }
+    _quantityMap[name] = quantity;
+
+    initQuantity(quantity, default_value);
+}
+
+template<typename T> void SDDistributed::addQuantityGroup(const std::vector<std::string>& names,
+        const T& default_value, const std::string& layout) {
+
+    if (layout == "SoA") {
+        for (const auto& name: names)
+            addQuantity(name, default_value);
+        return;
+    }
+
+    if (layout != "AoSoA")
+        exitfail("Unknown quantity layout: " + layout);
+
+    // Blocks of one cell are plain arrays: the group is stored as SoA, so
+    // that a quantity of one lane is always contiguous.
+    if (Quantity<T>::aosoaLanes == 1) {
+        addQuantityGroup(names, default_value, "SoA");
+        return;
+    }
+
+    const unsigned int nNames = names.size();
+    const unsigned int lanes = Quantity<T>::aosoaLanes;
+    const size_t blockStride = nNames * lanes;
+    const size_t groupSize = ((_coordConverter.getSize() + lanes - 1) / lanes) * blockStride;
+
+    // Both arrays in the arena (two blocks of nNames fields), or both on
+    // the heap.
+    T* dataLeft(nullptr);
+    T* dataRight(nullptr);
+    if (_quantityArena != nullptr && _quantityArena->hasRoom(2 * nNames, 2 * groupSize)) {
+        dataLeft = _quantityArena->allocateFields(nNames, groupSize);
+        dataRight = _quantityArena->allocateFields(nNames, groupSize);
+    } else {
+        // new T[] does not write the memory: pages are allocated on first touch.
+        _groupData.emplace_back(new T[2 * groupSize]);
+        dataLeft = _groupData.back().get();
+        dataRight = dataLeft + groupSize;
+    }
+
+    for (unsigned int q = 0; q < nNames; ++q) {
+        if (_quantityMap.find(names[q]) != _quantityMap.end())
+            exitfail("Quantity added twice: " + names[q]);
+
+        Quantity<T>* quantity = new Quantity<T>(names[q], _coordConverter.getSize(), _coordConverter,
+                dataLeft + q * lanes, dataRight + q * lanes, lanes, blockStride);
+        _quantityMap[names[q]] = quantity;
+        initQuantity(quantity, default_value);
+    }
+    _layout = layout;
+}
+
+template<typename T> void SDDistributed::initQuantity(Quantity<T>* quantity, const T& default_value) {
+
+    // Without threads, initialize everything from here.
+    if (_threadPool == nullptr || _SDSVector.empty()) {
+        for (unsigned int k = 0; k < _coordConverter.getSize(); ++k) {
+            quantity->set0(default_value, k);
+            quantity->set1(default_value, k);
+        }
+        return;
+    }
+
+    // First touch: the cells of a SDS are first written by the thread that
+    // computes it, so that their pages are allocated on its NUMA node. Tasks
+    // are dealt as the compute ones, SDS i to worker i % nThreads, and are not
+    // stolen. This only holds while the compute tasks are not stolen either.
+    const std::string taskName("firstTouch " + quantity->getName());
+    for (const auto& sds: _SDSVector) {
+        const SDShared* pSDS = &sds;
+        _threadPool->addTask(taskName, [quantity, pSDS, default_value]() {
+            for (const auto& range: pSDS->getRanges()) {
+                size_t k = pSDS->convert(range.x, range.y);
+                for (unsigned int i = 0; i < range.length; ++i, ++k) {
+                    quantity->set0(default_value, k);
+                    quantity->set1(default_value, k);
+                }
+            }
+        });
+    }
+    _threadPool->start(taskName, false);
+
+    // The tasks hold the quantity, which may be deleted before the pool.
+    _threadPool->clearTaskList(taskName);
+
+    // Boundary cells belong to no SDS.
+    const int b = _boundaryThickness;
+    const int sizeX = _sizeX;
+    const int sizeY = _sizeY;
+    for (int j = -b; j < sizeY + b; ++j) {
+        for (int i = -b; i < sizeX + b; ++i) {
+            // Skip the interior of the row.
+            if (j >= 0 && j < sizeY && i == 0)
+                i = sizeX;
+
+            size_t k = _coordConverter.convert(i, j);
+            quantity->set0(default_value, k);
+            quantity->set1(default_value, k);
+        }
+    }
 }
 
 #endif
@@ -3,12 +3,16 @@
 #include "SDShared.hpp"
 #include "exception/exception.hpp"
 
-SDShared::SDShared(const std::vector< std::pair<int, int> >& coords,
+SDShared::SDShared(const std::vector<CellRange>& ranges,
         const CoordConverter& coordConverter,
         unsigned int index):
-    std::vector< std::pair<int ,int> >(coords),
     _coordConverter(coordConverter),
-    _id(index) {
+    _id(index),
+    _ranges(ranges),
+    _nCells(0) {
+
+    for (const auto& range: _ranges)
+        _nCells += range.length;
 }
 
 void SDShared::execEquation(eqType& eqFunc,
@@ -89,6 +93,17 @@ void SDShared::updateTimeVaryingCells(Quantity<real>* quantity, const real& t) c
     }
 }
 
+void SDShared::copyTimeVaryingCells(Quantity<real>* quantity) const {
+    auto& qty(*quantity);
+
+    std::map<std::string, std::unordered_map< size_t, real >>::const_iterator it = _timeVaryingCellMap.find(qty.getName());
+    if (it == _timeVaryingCellMap.end())
+        return;
+
+    for (auto cit = it->second.begin(); cit != it->second.end(); ++cit)
+        qty.set1(qty.get0(cit->first), cit->first);
+}
+
 void SDShared::updateNeumannCells(Quantity<real>* quantity) const {
 
     auto& qty(*quantity);
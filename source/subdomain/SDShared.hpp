@@ -8,6 +8,7 @@
  */
 
 #include "CoordConverter.hpp"
+#include "Geometry.hpp"
 #include "Quantity.hpp"
 #include "engine.hpp"
 
@@ -25,19 +26,40 @@ typedef std::function< void(const SDShared&, const std::map< std::string, Quanti
  * @brief Subdomain on shared memory (SDS)
  *
  * Defines a subdomain on shared memory. Since the data
- * is stored as one block on the SDD, a SDS is only an
- * array of 2D-coordinates referencing to cells of the SDD.
+ * is stored as one block on the SDD, a SDS is only a
+ * list of ranges of cells of the SDD. The cells of a range
+ * are consecutive in memory, so that kernels loop over
+ * ranges, then over memory indices:
+ *
+ *     for (const auto& range: sds.getRanges()) {
+ *         size_t k = sds.convert(range.x, range.y);
+ *         for (int i = range.x; i < range.x + int(range.length); ++i, ++k)
+ *             ...
+ *     }
+ *
+ * Rectangles and lines are stored as one range per row, the random
+ * geometry as one range per cell.
  */
-class SDShared: public std::vector< std::pair<int,int> > {
+class SDShared {
   public:
 
     /*!
-     * @brief Copy constructor based on vector of coords
+     * @brief Constructor based on ranges of cells
      */
-    SDShared(const std::vector< std::pair<int, int> >& coords,
+    SDShared(const std::vector<CellRange>& ranges,
             const CoordConverter& coordConverter,
             unsigned int index);
 
+    /*!
+     * @brief Returns the ranges of cells of the SDS
+     */
+    inline const std::vector<CellRange>& getRanges() const { return _ranges; }
+
+    /*!
+     * @brief Returns the number of cells of the SDS
+     */
+    inline size_t size() const { return _nCells; }
+
     /*!
      * @brief Returns SDS id
      *
@@ -69,6 +91,13 @@ class SDShared: public std::vector< std::pair<int,int> > {
      */
     void updateBoundaryCells(Quantity<real>* quantity, const real& t) const;
 
+    /*!
+     * @brief Copies the current values of the time varying cells into the
+     * next array of the quantity, for quantities whose arrays are switched
+     * but whose boundary is only updated on the current array.
+     */
+    void copyTimeVaryingCells(Quantity<real>* quantity) const;
+
     void addTimeVaryingCell(std::pair < std::pair<int, int>, std::map<std::string, real> > d);
     void addDirichletCell(std::pair < std::pair<int, int>, std::map<std::string, real> > d);
     void addNeumannCell(std::pair< std::pair<int, int>, std::pair< std::pair<int, int>, std::map<std::string, real> > > n);
@@ -130,6 +159,9 @@ class SDShared: public std::vector< std::pair<int,int> > {
     CoordConverter _coordConverter;
     unsigned int _id;
 
+    std::vector<CellRange> _ranges;
+    size_t _nCells;
+
     /*!
      * mapping between coords of cells on which are
      * set Dirichlet boundary conditions, and the
@@ -10,18 +10,22 @@
 // Thread pool with single task method.
 class ThreadPool {
     public:
-        ThreadPool(size_t, size_t) {}
+        ThreadPool(size_t, const std::string& = "spin", const std::string& = "none") {}
         ~ThreadPool() {}
 
         void addTask(std::string taskListName, std::function<void()> f) {
             _taskListMap[taskListName].push_back(f);
         }
 
-        void start(const std::string& taskListName) {
+        void start(const std::string& taskListName, bool = true) {
             std::vector< std::function<void()> >* pTaskVector =  &(_taskListMap[taskListName]);
             for (size_t i = 0; i < pTaskVector->size(); ++i)
                 (*pTaskVector)[i]();
         }
+
+        void clearTaskList(const std::string& taskListName) {
+            _taskListMap.erase(taskListName);
+        }
     private:
         std::map<std::string, std::vector< std::function<void()> > > _taskListMap;
 };
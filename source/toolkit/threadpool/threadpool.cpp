@@ -1,6 +1,137 @@
 #include "threadpool.hpp"
+#include "exception/exception.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+    // Cores the threads are pinned to, in worker order: "compact" fills a
+    // socket before the next one, "scatter" deals the workers among the
+    // sockets, otherwise a comma separated list of core ids. Only cores
+    // allowed for the process (e.g. by mpirun) are used by compact/scatter.
+    std::vector<int> buildCoreList(const std::string& affinity) {
+        std::vector<int> coreList;
+
+        if (affinity != "compact" && affinity != "scatter") {
+            std::istringstream iss(affinity);
+            std::string core;
+            while (std::getline(iss, core, ','))
+                coreList.push_back(std::stoi(core));
+            return coreList;
+        }
+
+        #ifdef __linux__
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet);
+
+        // Allowed cores sorted by socket.
+        std::map<int, std::vector<int> > socketMap;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &cpuSet))
+                continue;
+
+            int socket(0);
+            std::ifstream ifs("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/physical_package_id");
+            if (ifs)
+                ifs >> socket;
+            socketMap[socket].push_back(cpu);
+        }
+
+        if (affinity == "compact") {
+            for (const auto& it: socketMap)
+                coreList.insert(coreList.end(), it.second.begin(), it.second.end());
+            return coreList;
+        }
+
+        for (size_t i = 0; coreList.size() < size_t(CPU_COUNT(&cpuSet)); ++i) {
+            for (const auto& it: socketMap)
+                if (i < it.second.size())
+                    coreList.push_back(it.second[i]);
+        }
+        #endif
+
+        return coreList;
+    }
+
+    void pinThread(std::thread::native_handle_type thread, int core) {
+        #ifdef __linux__
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core, &cpuSet);
+        if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0)
+            std::cerr << "Failed to pin thread to core " << core << std::endl;
+        #else
+        (void)thread; (void)core;
+        #endif
+    }
+}
+
+TaskDeque::TaskDeque() : _taskVector(nullptr), _top(0), _bottom(0) { }
+
+// To be called before any worker of the run is started (see ThreadPool::start):
+// nobody steals from it then, and the start of the workers publishes it.
+void TaskDeque::reset(std::vector< std::function<void()> >* taskVector) {
+    _top.store(0, std::memory_order_relaxed);
+    _taskVector.store(taskVector, std::memory_order_relaxed);
+    _bottom.store(taskVector->size(), std::memory_order_release);
+}
 
-Worker::Worker(ThreadPool &s, int id) : _pool(s), _id(id), _start(0), _coworkerA(nullptr) , _coworkerB(nullptr) { }
+// To be called by the owner only.
+std::function<void()>* TaskDeque::pop() {
+    long b = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    long t = _top.load(std::memory_order_relaxed);
+
+    // Empty.
+    if (t > b) {
+        _bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    std::function<void()>* task = &(*_taskVector.load(std::memory_order_relaxed))[b];
+
+    // Last task: race against thieves.
+    if (t == b) {
+        if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            task = nullptr;
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return task;
+}
+
+// To be called by any other worker.
+std::function<void()>* TaskDeque::steal() {
+    while (true) {
+        long t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long b = _bottom.load(std::memory_order_acquire);
+
+        // Empty.
+        if (t >= b)
+            return nullptr;
+
+        std::function<void()>* task = &(*_taskVector.load(std::memory_order_relaxed))[t];
+        if (_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return task;
+
+        // Lost the race with the owner or another thief, try again.
+    }
+}
+
+Worker::Worker(ThreadPool &s, int id) : _pool(s), _id(id), _start(0), _coworkerA(nullptr) , _coworkerB(nullptr)
+    #if PROFILE >= 1
+    , _wakeUpLatencyTotal(0), _wakeUpLatencyMax(0), _wakeUpCount(0)
+    #endif
+    { }
 
 void Worker::setCoworker(Worker* a, Worker* b) {_coworkerA = a; _coworkerB = b;}
 
@@ -18,78 +149,94 @@ void Worker::start(const std::string& taskListName) {
     if (_coworkerB != nullptr)
         _coworkerB->start(taskListName);
 
-    _ownTaskVector = &(_ownTaskVectorMap[taskListName]);
-    _ownTaskVectorSize = _ownTaskVector->size();
+    #if PROFILE >= 1
+    _startTime = steady_clock::now();
+    #endif
+
     ++_start;
+    wake();
 }
 
-// To be called by the thread.
-void Worker::_commonTask() {
-    int taskIndex(SYNC);
-    while (true) {
-        { // acquire lock
-            #ifndef SEQUENTIAL
-            std::lock_guard<std::mutex> lock(_pool._taskMutex);
-            #endif
-
-            // There is no common work available.
-            if (_pool._nextTaskCursor.load() == SYNC)
-                return;
+void Worker::wake() {
+    if (_pool._waitPolicy != ThreadPool::PARK)
+        return;
 
-            // get the task from the list
-            taskIndex = _pool._nextTaskCursor;
-
-            // Flag the pool to signal that one worker is computing.
-            ++_pool._nextTaskCursor;
-            if (_pool._nextTaskCursor.load() >= _pool._commonTaskVectorSize)
-                _pool._nextTaskCursor = SYNC;
+    // Taking the lock makes sure the worker is either not waiting yet (and
+    // will see the new state) or already asleep (and will get the signal).
+    { std::lock_guard<std::mutex> lock(_parkMutex); }
+    _parkCondition.notify_one();
+}
 
-        } // release lock
+// To be called by the thread once its own tasks are done.
+void Worker::_stealTasks() {
+    const size_t nWorkers(_pool._workerVector.size());
 
-        // execute the task
-        if (taskIndex >= 0) {
-            (*_pool._commonTaskVector)[taskIndex]();
-            taskIndex = SYNC;
-        }
+    // Visit the other workers, starting with the next one, and empty them.
+    for (size_t k = 1; k < nWorkers; ++k) {
+        Worker* victim = _pool._workerVector[(_id + k) % nWorkers];
+        while (std::function<void()>* task = victim->_taskDeque.steal())
+            (*task)();
     }
 }
 
 void Worker::work() {
 
-    // If all tasks were done (ie. end of simulation), kill thread
-    while (_pool._running) {
+    while (true) {
 
-        if (_start.load() > 0) {
+        _wait([this] { return _start.load() > 0 || !_pool._running.load(); });
 
-            // execute all the tasks
-            for (size_t i = 0; i < _ownTaskVectorSize; ++i)
-                (*_ownTaskVector)[i]();
+        // If all tasks were done (ie. end of simulation), kill thread
+        if (!_pool._running.load())
+            return;
 
-            // Now common part
-            _commonTask();
+        #if PROFILE >= 1
+        if (_id != 0) {
+            double latency = std::chrono::duration<double, std::nano>(steady_clock::now() - _startTime).count();
+            _wakeUpLatencyTotal += latency;
+            _wakeUpLatencyMax = std::max(_wakeUpLatencyMax, latency);
+            ++_wakeUpCount;
+        }
+        #endif
 
-            // Unflag the pool to signal that the worker is free.
-            --_pool._busyWorkerNumber;
+        // execute all the tasks
+        while (std::function<void()>* task = _taskDeque.pop())
+            (*task)();
 
-            // Job done
-            --_start;
-        }
+        // Now help the others
+        if (_pool._steal)
+            _stealTasks();
 
-        // If main thread, return when done (split to check which one is blocking the other in Vtune)
-        if (_id == 0)
-            if (_pool._busyWorkerNumber.load() == 0)
-                if( _pool._nextTaskCursor.load() == SYNC)
-                    return;
+        // Job done
+        --_start;
+
+        // Unflag the pool to signal that the worker is free, the last one
+        // wakes the main thread up.
+        if (--_pool._busyWorkerNumber == 0)
+            _pool._workerVector[0]->wake();
+
+        // If main thread, return when done
+        if (_id == 0) {
+            _wait([this] { return _pool._busyWorkerNumber.load() == 0; });
+            return;
+        }
     }
 }
 
 // the constructor just launches some amount of workers
-ThreadPool::ThreadPool(size_t nThreads, size_t commonSize):
+ThreadPool::ThreadPool(size_t nThreads, const std::string& waitPolicy,
+        const std::string& affinity):
+    _waitPolicy(SPIN),
     _running(true),
-    _nextTaskCursor(-1),
+    _steal(true),
     _busyWorkerNumber(0),
-    _workerVector(nThreads),
-    _commonSize(commonSize) {
+    _workerVector(nThreads) {
+
+    if (waitPolicy == "backoff")
+        _waitPolicy = BACKOFF;
+    else if (waitPolicy == "park")
+        _waitPolicy = PARK;
+    else if (waitPolicy != "spin")
+        exitfail("Unknown wait policy: " + waitPolicy);
 
     for(size_t i = 0; i < _workerVector.size(); ++i)
        _workerVector[i] = new Worker(*this, i);
@@ -110,17 +257,45 @@ ThreadPool::ThreadPool(size_t nThreads, size_t commonSize):
     size_t threadVectorSize(nThreads - 1);
     for(size_t i = 0; i < threadVectorSize; ++i)
         _threadVector.push_back(std::thread(&Worker::work, _workerVector[i+1]));
+
+    if (affinity == "none")
+        return;
+
+    // Pin the workers, the main thread is worker 0.
+    std::vector<int> coreList(buildCoreList(affinity));
+    if (coreList.empty())
+        exitfail("No core to pin the threads with affinity " + affinity);
+
+    pinThread(pthread_self(), coreList[0]);
+    for(size_t i = 0; i < threadVectorSize; ++i)
+        pinThread(_threadVector[i].native_handle(), coreList[(i + 1) % coreList.size()]);
 }
 
 // the destructor joins all threads
 ThreadPool::~ThreadPool() {
 
     #if PROFILE >= 1
-    _timer.report();
+    _timer.reportTotal();
+
+    double wakeUpLatencyTotal(0), wakeUpLatencyMax(0);
+    size_t wakeUpCount(0);
+    for (auto worker: _workerVector) {
+        wakeUpLatencyTotal += worker->_wakeUpLatencyTotal;
+        wakeUpLatencyMax = std::max(wakeUpLatencyMax, worker->_wakeUpLatencyMax);
+        wakeUpCount += worker->_wakeUpCount;
+    }
+
+    const char* policyName[] = {"spin", "backoff", "park"};
+    std::cout << "ThreadPool wait policy " << policyName[_waitPolicy] << ": wake-up latency mean ";
+    std::cout << (wakeUpCount > 0 ? wakeUpLatencyTotal / wakeUpCount : 0.) << " ns, max ";
+    std::cout << wakeUpLatencyMax << " ns over " << wakeUpCount << " wake-ups." << std::endl;
     #endif
 
     // join them
     _running = false;
+    for (size_t i = 1; i < _workerVector.size(); ++i)
+        _workerVector[i]->wake();
+
     for (auto it = _threadVector.begin(); it != _threadVector.end(); ++it) {
         if (it->joinable())
             it->join();
@@ -138,34 +313,29 @@ void ThreadPool::addTask(std::string taskListName, std::function<void()> f) {
 
     size_t dispatch = _dispatchMap[taskListName];
 
-    // Put it in the common task list.
-    if (dispatch < _commonSize) {
-        _taskListMap[taskListName].push_back(f);
-    } else {
-        // Pick a worker
-        size_t w = (dispatch + _commonSize) % _workerVector.size();
-        //size_t w = 1 + (dispatch + _commonSize) % (_workerVector.size() - 1);
-        _workerVector[w]->addTask(taskListName, f);
-    }
+    // Pick a worker, the others will steal from it if needed.
+    size_t w = dispatch % _workerVector.size();
+    _workerVector[w]->addTask(taskListName, f);
 
     ++_dispatchMap[taskListName];
 }
 
-void ThreadPool::start(const std::string& taskListName) {
+void ThreadPool::start(const std::string& taskListName, bool steal) {
     #if PROFILE >= 1
-    _timer.start();
+    _timer.begin();
     #endif
 
-    // This defines the common tasks
-    if (_commonSize > 0) {
-        _commonTaskVector = &(_taskListMap[taskListName]);
-        _commonTaskVectorSize = _commonTaskVector->size();
-        _nextTaskCursor = 0;
-    }
+    // Published to the workers by their start.
+    _steal = steal;
 
     // Flag the pool to signal that all workers are computing (they will try at least).
     _busyWorkerNumber = _workerVector.size();
 
+    // All the deques are filled before any worker starts, so that a worker
+    // stealing cannot see the deque of another one from the last run.
+    for (auto worker: _workerVector)
+        worker->_taskDeque.reset(&(worker->_ownTaskVectorMap[taskListName]));
+
     // Start the work of each thread
     _workerVector[0]->start(taskListName);
 
@@ -176,3 +346,11 @@ void ThreadPool::start(const std::string& taskListName) {
     _timer.end();
     #endif
 }
+
+void ThreadPool::clearTaskList(const std::string& taskListName) {
+
+    for (auto worker: _workerVector)
+        worker->_ownTaskVectorMap.erase(taskListName);
+
+    _dispatchMap.erase(taskListName);
+}
@@ -11,18 +11,36 @@
 #include <functional>
 #include <atomic>
 
-#include <mutex>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 #if PROFILE >= 1
 #include "timer/timer.hpp"
 #endif
 
-// This can be any less than zero value
-#define SYNC -1
-
 class ThreadPool;
 
+// Chase-Lev work-stealing deque. The owner pops tasks from the bottom, the
+// other workers steal from the top. Its content is the task list of the owner
+// and is only replaced between two runs, so the buffer never grows.
+class TaskDeque {
+    public:
+        TaskDeque();
+
+        void reset(std::vector< std::function<void()> >* taskVector);
+        std::function<void()>* pop();
+        std::function<void()>* steal();
+    private:
+        std::atomic< std::vector< std::function<void()> >* > _taskVector;
+        std::atomic<long> _top;
+        std::atomic<long> _bottom;
+};
+
 // Worker for thread pool object.
 class Worker {
     public:
@@ -32,8 +50,14 @@ class Worker {
         void work();
         void start(const std::string& taskListName);
         void addTask(std::string taskListName, std::function<void()> f);
+        void wake();
     private:
-        void _commonTask();
+        friend class ThreadPool;
+
+        void _stealTasks();
+
+        // Waits until ready() holds, according to the wait policy of the pool.
+        template<typename Predicate> void _wait(Predicate ready);
 
         ThreadPool& _pool;
         int _id;
@@ -42,41 +66,104 @@ class Worker {
         Worker* _coworkerB;
 
         std::map<std::string, std::vector< std::function<void()> > > _ownTaskVectorMap;
-        std::vector< std::function<void()> >* _ownTaskVector;
-        size_t _ownTaskVectorSize;
-        std::mutex _ownMutex;
+        TaskDeque _taskDeque;
+
+        // Where the worker sleeps with the park policy.
+        std::mutex _parkMutex;
+        std::condition_variable _parkCondition;
+
+        #if PROFILE >= 1
+        // Time between start() and the worker noticing it.
+        std::chrono::time_point<steady_clock> _startTime;
+        double _wakeUpLatencyTotal;
+        double _wakeUpLatencyMax;
+        size_t _wakeUpCount;
+        #endif
 };
 
-// Thread pool with single task method.
+// Thread pool with single task method. Tasks are dealt to the workers in
+// turn, idle workers then steal from the others. The second argument of the
+// constructor (number of common tasks) is kept for compatibility, stealing
+// does the job the common task list used to do.
+//
+// Between two runs, workers wait according to the wait policy given to the
+// constructor:
+//  - "spin": busy loop, lowest latency, burns a core per worker,
+//  - "backoff": busy loop, then _mm_pause with an exponential backoff,
+//  - "park": as backoff, then sleep on a condition variable.
+// With PROFILE >= 1, the wake-up latency of the workers is reported when the
+// pool is destroyed.
+//
+// The affinity pins worker i (worker 0 being the calling thread) to a core:
+// "none", "compact", "scatter" or an explicit list of cores "0,2,4,6".
 class ThreadPool {
     public:
-        ThreadPool(size_t, size_t);
+        ThreadPool(size_t, const std::string& waitPolicy = "spin",
+                const std::string& affinity = "none");
         ~ThreadPool();
 
         void addTask(std::string taskList_name, std::function<void()> f);
-        void start(const std::string& taskListName);
+
+        // Runs a task list. Without steal, each worker only runs the tasks it
+        // was dealt, ie. task i is run by worker i % nThreads.
+        void start(const std::string& taskListName, bool steal = true);
+
+        // Drops a task list once it is not to be run anymore, with what its
+        // tasks hold.
+        void clearTaskList(const std::string& taskListName);
 
     private:
         friend class Worker;
 
+        enum WaitPolicy { SPIN, BACKOFF, PARK };
 
-        std::vector< std::function<void()> >* _commonTaskVector;
-        int _commonTaskVectorSize = 0;
+        // Number of busy loops before pausing, and of pauses before parking.
+        static const unsigned int _spinCount = 1 << 10;
+        static const unsigned int _pauseCount = 1 << 14;
+        static const unsigned int _maxPauseBatch = 1 << 6;
 
-        std::map<std::string, std::vector< std::function<void()> > > _taskListMap;
+        WaitPolicy _waitPolicy;
         std::map<std::string, size_t> _dispatchMap;
         std::atomic<bool> _running;
-        std::atomic<int> _nextTaskCursor;
+        bool _steal;
         std::atomic<size_t> _busyWorkerNumber;
         std::vector<Worker*> _workerVector;
         std::vector< std::thread > _threadVector;
-        std::mutex _taskMutex;
 
         #if PROFILE >= 1
         Timer _timer;
         #endif
-        const size_t _commonSize;
 };
 
+template<typename Predicate> void Worker::_wait(Predicate ready) {
+
+    // Spin first, the next run is often about to start.
+    for (unsigned int i = 0; i < ThreadPool::_spinCount || _pool._waitPolicy == ThreadPool::SPIN; ++i)
+        if (ready())
+            return;
+
+    // Then leave the core to the sibling hyperthread, longer and longer.
+    unsigned int batch(1);
+    for (unsigned int i = 0; i < ThreadPool::_pauseCount || _pool._waitPolicy == ThreadPool::BACKOFF; i += batch) {
+        for (unsigned int k = 0; k < batch; ++k) {
+            #if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+            #else
+            std::this_thread::yield();
+            #endif
+        }
+
+        if (ready())
+            return;
+
+        if (batch < ThreadPool::_maxPauseBatch)
+            batch *= 2;
+    }
+
+    // Finally sleep until woken up.
+    std::unique_lock<std::mutex> lock(_parkMutex);
+    _parkCondition.wait(lock, ready);
+}
+
 #endif // THREADPOOL_H
 #endif // SEQUENTIAL
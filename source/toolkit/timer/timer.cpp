@@ -25,6 +25,14 @@ void Timer::end(){
     _call += 1.;
 }
 
+void Timer::setSteadyTimeDeque(const std::deque<unsigned long int>& steadyDeque) {
+    _steadyDeque = steadyDeque;
+    _totalSteady = 0.;
+    for (auto const& steady: _steadyDeque)
+        _totalSteady += steady;
+    _call = _steadyDeque.size();
+}
+
 unsigned long int Timer::getLastSteadyDuration() const {
     return std::chrono::duration_cast<std::chrono::milliseconds>(_endSteady - _startSteady).count();
 }
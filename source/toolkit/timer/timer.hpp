@@ -24,6 +24,9 @@ class Timer {
         double getMeanSteadyDuration() const;
         double getTotalSteadyDuration() const;
         const std::deque<unsigned long int>& getSteadyTimeDeque() const {return _steadyDeque;}
+
+        // Restores the durations of a previous run (see Engine checkpoints).
+        void setSteadyTimeDeque(const std::deque<unsigned long int>& steadyDeque);
     private:
         std::chrono::time_point<steady_clock> _startSteady, _endSteady;
         double _totalSteady;
@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+# -*- coding:utf-8 -*-
+
+# Checks that a run restarted from its checkpoints (-R) ends with the same
+# quantities and snapshots as the uninterrupted run, bit for bit, for several
+# exec options (see check_restart in script/launcher.py), e.g.:
+#   ./test_restart.py eulerRuO1 --case nSod --core 4
+
+import __future__
+import sys
+from seek_common import *
+
+
+nruns = 1
+SDSgeom = 'rectangle'
+sizeList = [(4096, 1)]
+schemeOptions = {'checkpointIterations': 7, 'checkpointKeep': 3, 'snapshotIterations': 5}
+execOptionsList = [
+            {},
+            {'sweep': 'fused'},
+            {'halo': 'overlap'},
+            {'dtReduction': 'pipelined'},
+            {'output': 'binary', 'cellOrder': 'hilbert', 'layout': 'AoSoA'},
+            ]
+
+testBattery = dict()
+for size in sizeList:
+    cn = "%s%sx%s" % (case_name, str(size[0]), str(size[1]))
+    for p in sorted(set([0, maxSdd - 1])):
+        for execOptions in execOptionsList:
+            test = dict()
+            test['nSDD'] = (2**p, 1)
+            test['nCoresPerSDD'] = 1
+            test['nThreads'] = 1
+            test['nSDS'] = 4
+            test['nCommonSDS'] = 0
+            test['execOptions'] = execOptions
+            test['schemeOptions'] = schemeOptions
+            testBattery.setdefault(cn, list()).append(test)
+
+battery = compileTestBattery([testBattery], SDSgeom, nruns)
+
+results = collectTestBattery(engineOptionDict, battery)
+print(COLOR_GREEN + "%s restart(s) checked" % len(results) + COLOR_ENDC)